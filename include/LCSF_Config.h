@@ -27,13 +27,30 @@
 #include <stdint.h>
 
 // --- LCSF Transcoder ---
-// #define LCSF_SMALL // Uncomment to use the smaller representation LCSF variant
+// #define LCSF_SMALL // Uncomment to use the smaller representation LCSF variant by default
 #define LCSF_TRANSCODER_RX_LIFO_SIZE 13 // Number of items (8 bytes / item)
 
+// --- LCSF Cursor ---
+#define LCSF_CURSOR_MAX_DEPTH 8 // Maximum number of nested sub-attribute levels
+
+// --- LCSF Builder ---
+#define LCSF_BUILDER_MAX_DEPTH 8 // Maximum number of nested sub-attribute levels
+
 // --- LCSF Validator ---
 #define LCSF_VALIDATOR_TX_LIFO_SIZE 13 // Number of items (8 bytes / item)
 #define LCSF_VALIDATOR_RX_LIFO_SIZE 13 // Number of items (8 bytes / item)
+#ifndef LCSF_VALIDATOR_RX_GEN_NB // Can be set by the build, the tests also run with 3
+#define LCSF_VALIDATOR_RX_GEN_NB 1 // Number of receiver lifos rotating per message, 2 or more to hold received commands
+#endif
 #define LCSF_VALIDATOR_PROTOCOL_NB 2
+#define LCSF_VALIDATOR_FIXED_CMD_NB 8 // Number of fixed layout commands received without attribute decoding
+#define LCSF_VALIDATOR_SHAPE_CACHE_NB 4 // Number of memoized message shapes, 0 to disable the shape cache
+#define LCSF_VALIDATOR_SHAPE_ATT_NB 16 // Maximum number of attributes (sub-attributes included) of a memoized shape
+
+// --- LCSF Lifo ---
+// Shared arena lifos are freed in the reverse order of their first allocation: each module frees its lifo before
+// returning, once the calls it made with its allocations alive are over.
+// #define LCSF_SHARED_ARENA // Uncomment to back all the stack and bridge lifos with the LcsfSharedArena user buffer
 
 #ifdef _APP_DEBUG
 #include <stdio.h>
@@ -0,0 +1,89 @@
+/**
+ * \file ChunkArena.h
+ * \brief Growable chained-chunk arena module, lifo allocator for hosted builds
+ * \author Jean-Roland Gosse
+ *
+ * This file is part of LCSF C Stack.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#ifndef _ChunkArena_h
+#define _ChunkArena_h
+
+// *** Libraries include ***
+// Standard lib
+// Custom lib
+#include <LCSF_Config.h>
+#include <lib/Lifo.h>
+
+// *** Definitions ***
+// --- Public Types ---
+
+// Forward declaration of the private chunk structure
+typedef struct _chunk_arena_chunk chunk_arena_chunk_t;
+
+/** Chunk arena structure */
+typedef struct _chunk_arena {
+    size_t ChunkSize; /**< Data size of a new chunk (bytes), larger if an allocation needs it */
+    size_t ChunkOffset; /**< Index of the first free byte in the current chunk */
+    chunk_arena_chunk_t *pFirstChunk; /**< Pointer to the first chunk of the chain */
+    chunk_arena_chunk_t *pCurrChunk; /**< Pointer to the chunk currently allocated from */
+} chunk_arena_t; // total: 16 bytes, 0 padding
+
+// --- Public Constants ---
+// --- Public Variables ---
+// --- Public Function Prototypes ---
+
+/**
+ * \fn bool ChunkArenaInit(chunk_arena_t *pArena, size_t chunkSize, lifo_allocator_t *pAllocator)
+ * \brief Initialize a chunk arena and its lifo allocator, chunks are allocated on demand
+ *
+ * \param pArena pointer to the arena
+ * \param chunkSize data size of a chunk (bytes)
+ * \param pAllocator pointer to contain the lifo allocator (optional)
+ * \return bool: true if operation was a success
+ */
+bool ChunkArenaInit(chunk_arena_t *pArena, size_t chunkSize, lifo_allocator_t *pAllocator);
+
+/**
+ * \fn void *ChunkArenaGet(void *pArena, size_t size)
+ * \brief Allocate memory from a chunk arena, a new chunk is chained if needed
+ *
+ * \param pArena pointer to the arena (chunk_arena_t)
+ * \param size allocation size (bytes)
+ * \return void *: pointer to the allocated memory, NULL if out of memory
+ */
+void *ChunkArenaGet(void *pArena, size_t size);
+
+/**
+ * \fn void ChunkArenaFreeAll(void *pArena)
+ * \brief Free all the allocations of a chunk arena, chunks are kept to be recycled
+ *
+ * \param pArena pointer to the arena (chunk_arena_t)
+ * \return void
+ */
+void ChunkArenaFreeAll(void *pArena);
+
+/**
+ * \fn void ChunkArenaRelease(chunk_arena_t *pArena)
+ * \brief Release the chunks of a chunk arena to the system
+ *
+ * \param pArena pointer to the arena
+ * \return void
+ */
+void ChunkArenaRelease(chunk_arena_t *pArena);
+
+// *** End Definitions ***
+#endif // _ChunkArena_h
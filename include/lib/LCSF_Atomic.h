@@ -0,0 +1,57 @@
+/**
+ * \file LCSF_Atomic.h
+ * \brief Light Command Set Format atomic accesses, for the variables shared between execution contexts
+ * \author Jean-Roland Gosse
+ *
+ * This file is part of LCSF C Stack.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#ifndef _LCSF_Atomic_h
+#define _LCSF_Atomic_h
+
+// *** Libraries include ***
+// Standard lib
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#endif
+// Custom lib
+#include <LCSF_Config.h>
+
+// *** Definitions ***
+// --- Public Macros ---
+
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+// Sequentially consistent accesses
+#define LCSF_ATOMIC(type) _Atomic(type)
+#define LCSF_ATOMIC_LOAD(pVar) atomic_load(pVar)
+#define LCSF_ATOMIC_STORE(pVar, value) atomic_store(pVar, value)
+#define LCSF_ATOMIC_FETCH_ADD(pVar, value) atomic_fetch_add(pVar, value)
+// Release store publishing the previous writes to the context doing the matching acquire load
+#define LCSF_ATOMIC_LOAD_ACQUIRE(pVar) atomic_load_explicit(pVar, memory_order_acquire)
+#define LCSF_ATOMIC_STORE_RELEASE(pVar, value) atomic_store_explicit(pVar, value, memory_order_release)
+#else
+// Single core targets without C11 atomics, volatile accesses keep their program order. C++ units only see the
+// types, their size and alignment match the C11 atomic ones for the integer and pointer types used by the stack.
+#define LCSF_ATOMIC(type) type volatile
+#define LCSF_ATOMIC_LOAD(pVar) (*(pVar))
+#define LCSF_ATOMIC_STORE(pVar, value) (*(pVar) = (value))
+#define LCSF_ATOMIC_FETCH_ADD(pVar, value) (*(pVar) += (value))
+#define LCSF_ATOMIC_LOAD_ACQUIRE(pVar) (*(pVar))
+#define LCSF_ATOMIC_STORE_RELEASE(pVar, value) (*(pVar) = (value))
+#endif
+
+// *** End Definitions ***
+#endif // _LCSF_Atomic_h
@@ -0,0 +1,173 @@
+/**
+ * \file LCSF_Builder.h
+ * \brief Light Command Set Format message builder module, encodes attributes straight into the send buffer
+ * \author Jean-Roland Gosse
+ *
+ * This file is part of LCSF C Stack.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#ifndef _LCSF_Builder_h
+#define _LCSF_Builder_h
+
+// *** Libraries include ***
+// Standard lib
+// Custom lib
+#include <LCSF_Config.h>
+#include <lib/LCSF_Transcoder.h>
+
+// *** Definitions ***
+// --- Public Types ---
+
+/** Lcsf builder structure */
+typedef struct _lcsf_builder {
+    uint8_t *pBuffer; /**< Pointer to the send buffer */
+    size_t BuffSize; /**< Send buffer size */
+    size_t BuffIdx; /**< Index of the next attribute header */
+    lcsf_repr_t Repr; /**< Message representation */
+    uint16_t Depth; /**< Current attribute level, 0 for the message attributes */
+    bool HasError; /**< Indicates if an operation failed, the message can't be completed */
+    size_t CountIdxArray[LCSF_BUILDER_MAX_DEPTH + 1]; /**< Index of the attribute number field to patch per level */
+    uint16_t AttNbArray[LCSF_BUILDER_MAX_DEPTH + 1]; /**< Number of attributes added per level */
+} lcsf_builder_t;
+
+// --- Public Constants ---
+// --- Public Variables ---
+// --- Public Function Prototypes ---
+
+/**
+ * \fn bool LCSF_BuilderBeginMsg(lcsf_builder_t *pBuilder, uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr, uint_fast16_t protId, uint_fast16_t protVer, uint_fast16_t cmdId)
+ * \brief Start a message, its header is written with an attribute number patched by LCSF_BuilderEndMsg
+ *
+ * \param pBuilder pointer to the builder
+ * \param pBuffer pointer to the send buffer
+ * \param buffSize send buffer size
+ * \param repr message representation
+ * \param protId protocol identifier
+ * \param protVer protocol version
+ * \param cmdId command identifier
+ * \return bool: true if operation was a success
+ */
+bool LCSF_BuilderBeginMsg(lcsf_builder_t *pBuilder, uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr,
+    uint_fast16_t protId, uint_fast16_t protVer, uint_fast16_t cmdId);
+
+/**
+ * \fn bool LCSF_BuilderAddBytes(lcsf_builder_t *pBuilder, uint_fast16_t attId, const void *pData, size_t dataSize)
+ * \brief Add a data attribute to the current level
+ *
+ * \param pBuilder pointer to the builder
+ * \param attId attribute identifier
+ * \param pData pointer to the attribute data
+ * \param dataSize attribute data size
+ * \return bool: true if operation was a success
+ */
+bool LCSF_BuilderAddBytes(lcsf_builder_t *pBuilder, uint_fast16_t attId, const void *pData, size_t dataSize);
+
+/**
+ * \fn bool LCSF_BuilderAddU8(lcsf_builder_t *pBuilder, uint_fast16_t attId, uint8_t value)
+ * \brief Add an 8-bit integer attribute to the current level
+ *
+ * \param pBuilder pointer to the builder
+ * \param attId attribute identifier
+ * \param value attribute value
+ * \return bool: true if operation was a success
+ */
+bool LCSF_BuilderAddU8(lcsf_builder_t *pBuilder, uint_fast16_t attId, uint8_t value);
+
+/**
+ * \fn bool LCSF_BuilderAddU16(lcsf_builder_t *pBuilder, uint_fast16_t attId, uint16_t value)
+ * \brief Add a 16-bit integer attribute to the current level
+ *
+ * \param pBuilder pointer to the builder
+ * \param attId attribute identifier
+ * \param value attribute value
+ * \return bool: true if operation was a success
+ */
+bool LCSF_BuilderAddU16(lcsf_builder_t *pBuilder, uint_fast16_t attId, uint16_t value);
+
+/**
+ * \fn bool LCSF_BuilderAddU32(lcsf_builder_t *pBuilder, uint_fast16_t attId, uint32_t value)
+ * \brief Add a 32-bit integer attribute to the current level
+ *
+ * \param pBuilder pointer to the builder
+ * \param attId attribute identifier
+ * \param value attribute value
+ * \return bool: true if operation was a success
+ */
+bool LCSF_BuilderAddU32(lcsf_builder_t *pBuilder, uint_fast16_t attId, uint32_t value);
+
+/**
+ * \fn bool LCSF_BuilderAddU64(lcsf_builder_t *pBuilder, uint_fast16_t attId, uint64_t value)
+ * \brief Add a 64-bit integer attribute to the current level
+ *
+ * \param pBuilder pointer to the builder
+ * \param attId attribute identifier
+ * \param value attribute value
+ * \return bool: true if operation was a success
+ */
+bool LCSF_BuilderAddU64(lcsf_builder_t *pBuilder, uint_fast16_t attId, uint64_t value);
+
+/**
+ * \fn bool LCSF_BuilderAddVle(lcsf_builder_t *pBuilder, uint_fast16_t attId, uint64_t value)
+ * \brief Add a variable length integer attribute to the current level, sized with GetVLESize
+ *
+ * \param pBuilder pointer to the builder
+ * \param attId attribute identifier
+ * \param value attribute value
+ * \return bool: true if operation was a success
+ */
+bool LCSF_BuilderAddVle(lcsf_builder_t *pBuilder, uint_fast16_t attId, uint64_t value);
+
+/**
+ * \fn bool LCSF_BuilderAddString(lcsf_builder_t *pBuilder, uint_fast16_t attId, const char *pString)
+ * \brief Add a string attribute to the current level, terminating null character included
+ *
+ * \param pBuilder pointer to the builder
+ * \param attId attribute identifier
+ * \param pString pointer to the string
+ * \return bool: true if operation was a success
+ */
+bool LCSF_BuilderAddString(lcsf_builder_t *pBuilder, uint_fast16_t attId, const char *pString);
+
+/**
+ * \fn bool LCSF_BuilderBeginGroup(lcsf_builder_t *pBuilder, uint_fast16_t attId)
+ * \brief Add an attribute with sub-attributes to the current level and enter its level
+ *
+ * \param pBuilder pointer to the builder
+ * \param attId attribute identifier
+ * \return bool: true if operation was a success
+ */
+bool LCSF_BuilderBeginGroup(lcsf_builder_t *pBuilder, uint_fast16_t attId);
+
+/**
+ * \fn bool LCSF_BuilderEndGroup(lcsf_builder_t *pBuilder)
+ * \brief Leave the current sub-attribute level, its sub-attribute number is patched in the group header
+ *
+ * \param pBuilder pointer to the builder
+ * \return bool: true if operation was a success
+ */
+bool LCSF_BuilderEndGroup(lcsf_builder_t *pBuilder);
+
+/**
+ * \fn int LCSF_BuilderEndMsg(lcsf_builder_t *pBuilder)
+ * \brief Complete a message, its attribute number is patched in the message header
+ *
+ * \param pBuilder pointer to the builder
+ * \return int: -1 if operation fail (failed operation, open group), encoded message size if success
+ */
+int LCSF_BuilderEndMsg(lcsf_builder_t *pBuilder);
+
+// *** End Definitions ***
+#endif // _LCSF_Builder_h
@@ -0,0 +1,122 @@
+/**
+ * \file LCSF_Cursor.h
+ * \brief Light Command Set Format attribute cursor module, reads attributes in place without attribute tree
+ * \author Jean-Roland Gosse
+ *
+ * This file is part of LCSF C Stack.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#ifndef _LCSF_Cursor_h
+#define _LCSF_Cursor_h
+
+// *** Libraries include ***
+// Standard lib
+// Custom lib
+#include <LCSF_Config.h>
+#include <lib/LCSF_Transcoder.h>
+
+// *** Definitions ***
+// --- Public Types ---
+
+/** Lcsf cursor structure */
+typedef struct _lcsf_cursor {
+    const uint8_t *pBuffer; /**< Pointer to the encoded message */
+    size_t BuffSize; /**< Encoded message size */
+    size_t BuffIdx; /**< Index of the next attribute header */
+    lcsf_repr_t Repr; /**< Encoded message representation */
+    uint16_t Depth; /**< Current attribute level, 0 for the message attributes */
+    uint16_t PendingSubAttNb; /**< Sub-attribute number of the last attribute read, skipped if not entered */
+    bool HasError; /**< Indicates if the encoded message was found malformed */
+    uint16_t AttLeftArray[LCSF_CURSOR_MAX_DEPTH + 1]; /**< Number of attributes left to read per level */
+} lcsf_cursor_t;
+
+/** Lcsf flat node structure, attributes of a message in preorder */
+typedef struct _lcsf_flat_node {
+    uint16_t AttId : 15; /**< Attribute identifier */
+    uint16_t HasSubAtt : 1; /**< Indicates if the attribute has sub-attributes */
+    uint16_t PayloadSize; /**< Attribute data size or sub-attribute number */
+    uint32_t Offset; /**< Data offset in the encoded message, or index of the node after the sub-attributes */
+} lcsf_flat_node_t; // total: 8 bytes, 0 padding
+
+// --- Public Constants ---
+// --- Public Variables ---
+// --- Public Function Prototypes ---
+
+/**
+ * \fn bool LCSF_CursorInit(lcsf_cursor_t *pCursor, const uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr, lcsf_raw_msg_t *pHeader)
+ * \brief Initialize a cursor on an encoded message and read its header
+ *
+ * \param pCursor pointer to the cursor
+ * \param pBuffer pointer to the encoded message (must stay valid while the cursor is in use)
+ * \param buffSize encoded message size
+ * \param repr encoded message representation
+ * \param pHeader pointer to contain the message header (optional, attribute array pointer is set to NULL)
+ * \return bool: true if operation was a success
+ */
+bool LCSF_CursorInit(
+    lcsf_cursor_t *pCursor, const uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr, lcsf_raw_msg_t *pHeader);
+
+/**
+ * \fn bool LCSF_CursorNext(lcsf_cursor_t *pCursor, lcsf_raw_att_t *pAtt)
+ * \brief Read the next attribute of the current level, sub-attributes of the previous one are skipped if not entered
+ *
+ * \param pCursor pointer to the cursor
+ * \param pAtt pointer to contain the attribute, data payload points into the encoded message, sub-attribute payload
+ * is NULL
+ * \return bool: true if an attribute was read, false at the end of the level or if the message is malformed
+ * (HasError is set)
+ */
+bool LCSF_CursorNext(lcsf_cursor_t *pCursor, lcsf_raw_att_t *pAtt);
+
+/**
+ * \fn bool LCSF_CursorEnter(lcsf_cursor_t *pCursor)
+ * \brief Enter the sub-attribute level of the last attribute read
+ *
+ * \param pCursor pointer to the cursor
+ * \return bool: true if operation was a success
+ */
+bool LCSF_CursorEnter(lcsf_cursor_t *pCursor);
+
+/**
+ * \fn bool LCSF_CursorLeave(lcsf_cursor_t *pCursor)
+ * \brief Leave the current sub-attribute level, its attributes left are skipped
+ *
+ * \param pCursor pointer to the cursor
+ * \return bool: true if operation was a success
+ */
+bool LCSF_CursorLeave(lcsf_cursor_t *pCursor);
+
+/**
+ * \fn bool LCSF_CursorDecodeFlat(const uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr, lcsf_raw_msg_t *pHeader, lcsf_flat_node_t *pNodeArray, size_t nodeArraySize, size_t *pNodeNb)
+ * \brief Decode the attributes of an encoded message into a contiguous preorder node array
+ *
+ * The sub-attributes of a node start at the next index, a node with sub-attributes notes the index where its
+ * siblings resume. The attributes must fill the message exactly.
+ *
+ * \param pBuffer pointer to the encoded message (node offsets refer to it)
+ * \param buffSize encoded message size
+ * \param repr encoded message representation
+ * \param pHeader pointer to contain the message header (optional, attribute array pointer is set to NULL)
+ * \param pNodeArray pointer to contain the nodes
+ * \param nodeArraySize number of nodes the array can hold
+ * \param pNodeNb pointer to contain the number of decoded nodes
+ * \return bool: true if operation was a success
+ */
+bool LCSF_CursorDecodeFlat(const uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr, lcsf_raw_msg_t *pHeader,
+    lcsf_flat_node_t *pNodeArray, size_t nodeArraySize, size_t *pNodeNb);
+
+// *** End Definitions ***
+#endif // _LCSF_Cursor_h
@@ -0,0 +1,97 @@
+/**
+ * \file LCSF_DescBlob.h
+ * \brief Light Command Set Format descriptor blob module, loads relocatable packed descriptors in place
+ * \author Jean-Roland Gosse
+ *
+ * This file is part of LCSF C Stack.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#ifndef _LCSF_DescBlob_h
+#define _LCSF_DescBlob_h
+
+// *** Libraries include ***
+// Standard lib
+// Custom lib
+#include <LCSF_Config.h>
+#include <lib/LCSF_Validator.h>
+
+// *** Definitions ***
+// --- Public Types ---
+
+/** Lcsf descriptor blob header structure, followed by the command records then the attribute records */
+typedef struct _lcsf_blob_header {
+    uint8_t Magic[4]; /**< Blob marker, "LCSF" */
+    uint16_t Layout; /**< Layout version, written in the writer byte order */
+    uint16_t ProtId; /**< Protocol identifier */
+    uint16_t ProtVer; /**< Protocol version */
+    uint16_t CmdNb; /**< Number of command records */
+    uint16_t AttNb; /**< Number of attribute records */
+    uint16_t Reserved; /**< Unused, must be 0 */
+} lcsf_blob_header_t; // total: 16 bytes, 0 padding
+
+/** Lcsf loaded blob protocol structure, must stay valid while the protocol is registered */
+typedef struct _lcsf_blob_prot {
+    lcsf_packed_prot_desc_t PackedDesc; /**< Packed descriptor pointing into the blob */
+    lcsf_validator_protocol_desc_t Entry; /**< Validator protocol entry */
+} lcsf_blob_prot_t;
+
+// --- Public Constants ---
+// --- Public Variables ---
+// --- Public Function Prototypes ---
+
+/**
+ * \fn int LCSF_DescBlobWrite(uint_fast16_t protId, uint_fast16_t protVer, const lcsf_packed_prot_desc_t *pPackedDesc, uint8_t *pBuffer, size_t buffSize)
+ * \brief Write a packed protocol descriptor as a blob (records are stored in the host layout)
+ *
+ * \param protId protocol identifier
+ * \param protVer protocol version
+ * \param pPackedDesc pointer to the packed protocol descriptor
+ * \param pBuffer pointer to the blob buffer
+ * \param buffSize blob buffer size
+ * \return int: -1 if operation fail, blob size if success
+ */
+int LCSF_DescBlobWrite(uint_fast16_t protId, uint_fast16_t protVer, const lcsf_packed_prot_desc_t *pPackedDesc,
+    uint8_t *pBuffer, size_t buffSize);
+
+/**
+ * \fn bool LCSF_DescBlobLoad(const uint8_t *pBlob, size_t blobSize, LCSFInterpretCallback_t *pFnInterpretMsg, lcsf_blob_prot_t *pBlobProt)
+ * \brief Check a blob then fill a protocol entry using its records in place, without copy
+ *
+ * \param pBlob pointer to the blob (2-byte aligned, must stay valid while the protocol is registered)
+ * \param blobSize blob size
+ * \param pFnInterpretMsg pointer to the message interpretation function
+ * \param pBlobProt pointer to contain the protocol
+ * \return bool: true if operation was a success
+ */
+bool LCSF_DescBlobLoad(
+    const uint8_t *pBlob, size_t blobSize, LCSFInterpretCallback_t *pFnInterpretMsg, lcsf_blob_prot_t *pBlobProt);
+
+/**
+ * \fn bool LCSF_DescBlobAddProtocol(uint_fast16_t protIdx, const uint8_t *pBlob, size_t blobSize, LCSFInterpretCallback_t *pFnInterpretMsg, lcsf_blob_prot_t *pBlobProt)
+ * \brief Load a blob then add its protocol to the validator
+ *
+ * \param protIdx index of the protocol
+ * \param pBlob pointer to the blob (e.g. a mapped file)
+ * \param blobSize blob size
+ * \param pFnInterpretMsg pointer to the message interpretation function
+ * \param pBlobProt pointer to contain the protocol
+ * \return bool: true if operation was a success
+ */
+bool LCSF_DescBlobAddProtocol(uint_fast16_t protIdx, const uint8_t *pBlob, size_t blobSize,
+    LCSFInterpretCallback_t *pFnInterpretMsg, lcsf_blob_prot_t *pBlobProt);
+
+// *** End Definitions ***
+#endif // _LCSF_DescBlob_h
@@ -0,0 +1,135 @@
+/**
+ * \file LCSF_RxRing.h
+ * \brief Light Command Set Format receive ring module, leases received frames while the next ones are filled
+ * \author Jean-Roland Gosse
+ *
+ * This file is part of LCSF C Stack.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#ifndef _LCSF_RxRing_h
+#define _LCSF_RxRing_h
+
+// *** Libraries include ***
+// Standard lib
+// Custom lib
+#include <LCSF_Config.h>
+#include <lib/LCSF_Atomic.h>
+#include <lib/LCSF_Transcoder.h>
+
+// *** Definitions ***
+// --- Public Types ---
+
+/** Receive ring slot structure, one per frame buffer */
+typedef struct _lcsf_rx_slot {
+    LCSF_ATOMIC(uint8_t) State; /**< Slot state (free, ready or leased), released to the other context */
+    uint8_t LeaseMask; /**< Bitmap of the leases held on the frame */
+    uint16_t Generation; /**< Incremented each time the frame is leased, invalidates stale lease tokens */
+    size_t FrameSize; /**< Size of the received frame */
+} lcsf_rx_slot_t; // total: 8 bytes, 0 padding
+
+/** Receive ring structure, filled by one context (e.g. a dma interrupt) and processed by another */
+typedef struct _lcsf_rx_ring {
+    uint8_t *pData; /**< Pointer to the slot buffers, SlotNb * SlotSize bytes */
+    lcsf_rx_slot_t *pSlotArray; /**< Pointer to the slot array */
+    size_t SlotSize; /**< Size of a slot buffer */
+    uint16_t SlotNb; /**< Number of slots */
+    uint16_t FillIdx; /**< Index of the slot to fill next, only written by the filling context */
+    uint16_t ProcessIdx; /**< Index of the slot to process next, only written by the processing context */
+    uint16_t CurrSlotIdx; /**< Index of the slot being processed, SlotNb if none */
+} lcsf_rx_ring_t; // total: 20 bytes, 0 padding
+
+/** Receive frame lease token */
+typedef struct _lcsf_rx_lease {
+    uint16_t SlotIdx; /**< Index of the leased slot */
+    uint16_t Generation; /**< Slot generation when leased */
+    uint8_t LeaseIdx; /**< Index of the lease in the slot lease bitmap */
+} lcsf_rx_lease_t; // total: 6 bytes, 1 padding
+
+// --- Public Constants ---
+// --- Public Variables ---
+// --- Public Function Prototypes ---
+
+/**
+ * \fn bool LCSF_RxRingInit(lcsf_rx_ring_t *pRing, uint8_t *pData, size_t slotSize, lcsf_rx_slot_t *pSlotArray, size_t slotNb)
+ * \brief Initialize a receive ring, two slots make a ping-pong buffer
+ *
+ * \param pRing pointer to the ring
+ * \param pData pointer to the slot buffers (slotNb * slotSize bytes)
+ * \param slotSize size of a slot buffer, the largest frame size
+ * \param pSlotArray pointer to the slot array
+ * \param slotNb number of slots
+ * \return bool: true if operation was a success
+ */
+bool LCSF_RxRingInit(lcsf_rx_ring_t *pRing, uint8_t *pData, size_t slotSize, lcsf_rx_slot_t *pSlotArray, size_t slotNb);
+
+/**
+ * \fn uint8_t *LCSF_RxRingGetFillBuffer(lcsf_rx_ring_t *pRing)
+ * \brief Retrieve the buffer to fill with the next frame, filling context only
+ *
+ * Slots are filled in order, a slot still leased holds back the next fills.
+ *
+ * \param pRing pointer to the ring
+ * \return uint8_t *: pointer to the buffer (SlotSize bytes), NULL if the ring is full
+ */
+uint8_t *LCSF_RxRingGetFillBuffer(lcsf_rx_ring_t *pRing);
+
+/**
+ * \fn bool LCSF_RxRingCommit(lcsf_rx_ring_t *pRing, size_t frameSize)
+ * \brief Hand the filled buffer over to the processing context, filling context only
+ *
+ * \param pRing pointer to the ring
+ * \param frameSize size of the received frame
+ * \return bool: true if operation was a success
+ */
+bool LCSF_RxRingCommit(lcsf_rx_ring_t *pRing, size_t frameSize);
+
+/**
+ * \fn bool LCSF_RxRingProcess(lcsf_rx_ring_t *pRing, lcsf_receive_status_t *pStatus)
+ * \brief Receive the oldest filled frame through LCSF_TranscoderReceive, processing context only
+ *
+ * The frame is leased while it is received, the interpretation functions extend the lease with LCSF_RxRingRetain
+ * to keep its data after they return. The attribute arrays are released once the frame is received.
+ *
+ * \param pRing pointer to the ring
+ * \param pStatus pointer to contain the receive status
+ * \return bool: true if a frame was received
+ */
+bool LCSF_RxRingProcess(lcsf_rx_ring_t *pRing, lcsf_receive_status_t *pStatus);
+
+/**
+ * \fn bool LCSF_RxRingRetain(lcsf_rx_ring_t *pRing, lcsf_rx_lease_t *pLease)
+ * \brief Take a lease on the frame being received, to be called from an interpretation function
+ *
+ * A frame holds up to 8 leases, the receive lease included.
+ *
+ * \param pRing pointer to the ring
+ * \param pLease pointer to contain the lease token
+ * \return bool: true if operation was a success
+ */
+bool LCSF_RxRingRetain(lcsf_rx_ring_t *pRing, lcsf_rx_lease_t *pLease);
+
+/**
+ * \fn bool LCSF_RxRingRelease(lcsf_rx_ring_t *pRing, const lcsf_rx_lease_t *pLease)
+ * \brief Release a lease, the slot is refilled once all its leases are released, processing context only
+ *
+ * \param pRing pointer to the ring
+ * \param pLease pointer to the lease token
+ * \return bool: true if operation was a success, false if the token is stale or already released
+ */
+bool LCSF_RxRingRelease(lcsf_rx_ring_t *pRing, const lcsf_rx_lease_t *pLease);
+
+// *** End Definitions ***
+#endif // _LCSF_RxRing_h
@@ -29,6 +29,20 @@
 
 // *** Definitions ***
 // --- Public Types ---
+
+/** Lcsf representation enum */
+typedef enum _lcsf_repr {
+    LCSF_REPR_STANDARD = 0, /**< Standard representation, 16-bit header fields */
+    LCSF_REPR_SMALL, /**< Smaller representation, 8-bit header fields (7-bit attribute id) */
+} lcsf_repr_t;
+
+// Default representation, selected with LCSF_SMALL
+#ifdef LCSF_SMALL
+#define LCSF_REPR_DEFAULT LCSF_REPR_SMALL
+#else
+#define LCSF_REPR_DEFAULT LCSF_REPR_STANDARD
+#endif
+
 // Forward declaration to resolve cross referencing
 typedef struct _lcsf_raw_att lcsf_raw_att_t;
 
@@ -66,9 +80,27 @@ typedef enum _lcsf_receive_status {
     LCSF_RECEIVE_MISS_NONOPT_ATT, /**< Missing non-optional attribute */
     LCSF_RECEIVE_WRONG_ATT_DATA_TYPE, /**< Wrong attribute data type */
     LCSF_RECEIVE_BAD_PROT_VER, /**< Protocol version mismatch */
+    LCSF_RECEIVE_FILTERED, /**< Command not subscribed, message dropped without decoding */
+    LCSF_RECEIVE_FORWARDED, /**< Message forwarded as is by a route, not decoded */
 } lcsf_receive_status_t;
 
+// Callback prototype
+typedef bool(LCSFForwardCallback_t)(const uint8_t *pBuffer, size_t buffSize);
+
+/** Lcsf route structure */
+typedef struct _lcsf_route {
+    uint16_t ProtId; /**< Protocol identifier */
+    uint16_t CmdId; /**< Command identifier */
+    bool IsAnyCmd; /**< Indicates if the route matches all the protocol commands (CmdId is ignored) */
+    LCSFForwardCallback_t *pFnForward; /**< Function pointer to send the message on the destination link */
+} lcsf_route_t; // total: 12 bytes, 3 padding
+
 // --- Public Constants ---
+
+// Lcsf error protocol (LCSF_EP) id per representation (0xFF in the smaller one to fit the 8-bit id field)
+#define LCSF_ERROR_PROTOCOL_ID 0xFFFF
+#define LCSF_ERROR_PROTOCOL_ID_SMALL 0x00FF
+
 // --- Public Variables ---
 // --- Public Function Prototypes ---
 
@@ -80,9 +112,22 @@ typedef enum _lcsf_receive_status {
  */
 bool LCSF_TranscoderInit(void);
 
+/**
+ * \fn bool LCSF_TranscoderSetRoutes(const lcsf_route_t *pRouteArray, size_t routeNb)
+ * \brief Set the routing table, received messages matching a route are forwarded as is instead of being decoded
+ *
+ * \param pRouteArray pointer to the route array (must stay valid while in use), first matching route is used,
+ * NULL to disable routing
+ * \param routeNb number of routes in the array
+ * \return bool: true if operation was a success
+ */
+bool LCSF_TranscoderSetRoutes(const lcsf_route_t *pRouteArray, size_t routeNb);
+
 /**
  * \fn bool LCSF_TranscoderReceive(const uint8_t *pBuffer, size_t buffSize)
- * \brief Decode a buffer into a raw lcsf message and pass it to receiver
+ * \brief Decode a buffer in the default representation into a raw lcsf message and pass it to receiver
+ *
+ * Attribute data points into the buffer, it must not be re-written while the data is in use (see LCSF_RxRing).
  *
  * \param pBuffer pointer to the data to decode
  * \param buffSize buffer size
@@ -90,9 +135,21 @@ bool LCSF_TranscoderInit(void);
  */
 lcsf_receive_status_t LCSF_TranscoderReceive(const uint8_t *pBuffer, size_t buffSize);
 
+/**
+ * \fn lcsf_receive_status_t LCSF_TranscoderReceiveRepr(const uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr)
+ * \brief Decode a buffer into a raw lcsf message and pass it to receiver, messages encoded while it is processed
+ * (responses, errors) use the same representation
+ *
+ * \param pBuffer pointer to the data to decode
+ * \param buffSize buffer size
+ * \param repr representation of the buffer (the receiving link)
+ * \return lcsf_receive_status_t: LCSF_RECEIVE_OK if processed, otherwise the matching LCSF_RECEIVE_* error status
+ */
+lcsf_receive_status_t LCSF_TranscoderReceiveRepr(const uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr);
+
 /**
  * \fn int LCSF_TranscoderEncode(const lcsf_raw_msg_t *pMessage, uint8_t* pBuffer, size_t buffSize)
- * \brief Encode a raw lcsf message into a buffer
+ * \brief Encode a raw lcsf message into a buffer in the default representation
  *
  * \param pMessage pointer to the raw lcsf message to encode
  * \param pBuffer pointer to the send buffer
@@ -101,5 +158,36 @@ lcsf_receive_status_t LCSF_TranscoderReceive(const uint8_t *pBuffer, size_t buff
  */
 int LCSF_TranscoderEncode(const lcsf_raw_msg_t *pMessage, uint8_t *pBuffer, size_t buffSize);
 
+/**
+ * \fn int LCSF_TranscoderEncodeRepr(const lcsf_raw_msg_t *pMessage, uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr)
+ * \brief Encode a raw lcsf message into a buffer in a given representation
+ *
+ * \param pMessage pointer to the raw lcsf message to encode
+ * \param pBuffer pointer to the send buffer
+ * \param buffSize buffer size
+ * \param repr representation of the buffer (the sending link)
+ * \return int: -1 if operation fail (including header fields too large for the representation), encoded message size
+ * if success
+ */
+int LCSF_TranscoderEncodeRepr(const lcsf_raw_msg_t *pMessage, uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr);
+
+/**
+ * \fn int LCSF_TranscoderConvert(const uint8_t *pInBuffer, size_t inSize, lcsf_repr_t inRepr, uint8_t *pOutBuffer,
+ * size_t outSize, lcsf_repr_t outRepr)
+ * \brief Convert an encoded message to another representation in a single pass, only the headers are rewritten
+ * (lcsf error protocol id included), payloads are copied without decoding or validation
+ *
+ * \param pInBuffer pointer to the message to convert
+ * \param inSize message size
+ * \param inRepr message representation
+ * \param pOutBuffer pointer to the output buffer (must not overlap the message)
+ * \param outSize output buffer size
+ * \param outRepr output representation
+ * \return int: -1 if operation fail (malformed message, header fields too large for the output representation),
+ * converted message size if success
+ */
+int LCSF_TranscoderConvert(const uint8_t *pInBuffer, size_t inSize, lcsf_repr_t inRepr, uint8_t *pOutBuffer,
+    size_t outSize, lcsf_repr_t outRepr);
+
 // *** End Definitions ***
 #endif // _LCSF_Transcoder_h
\ No newline at end of file
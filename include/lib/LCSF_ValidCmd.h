@@ -0,0 +1,87 @@
+/**
+ * \file LCSF_ValidCmd.h
+ * \brief Light Command Set Format valid command module, detaches validated commands into relocatable blobs
+ * \author Jean-Roland Gosse
+ *
+ * This file is part of LCSF C Stack.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ */
+
+#ifndef _LCSF_ValidCmd_h
+#define _LCSF_ValidCmd_h
+
+// *** Libraries include ***
+// Standard lib
+// Custom lib
+#include <LCSF_Config.h>
+#include <lib/LCSF_Validator.h>
+
+// *** Definitions ***
+// --- Public Types ---
+
+/**
+ * Lcsf detached command header, followed by the attribute arrays then the payload bytes. Payload pointers of the
+ * attribute arrays hold offsets from the header until the blob is attached
+ */
+typedef struct _lcsf_detached_cmd {
+    uint16_t CmdId; /**< Command identifier */
+    uint16_t AttNb; /**< Number of attributes of the command descriptor */
+    uint32_t BlobSize; /**< Total blob size */
+} lcsf_detached_cmd_t; // total: 8 bytes, 0 padding
+
+// --- Public Constants ---
+// --- Public Variables ---
+// --- Public Function Prototypes ---
+
+/**
+ * \fn int LCSF_ValidCmdGetDetachSize(const lcsf_valid_cmd_t *pCmd, const lcsf_command_desc_t *pDesc)
+ * \brief Compute the size of the blob of a detached command
+ *
+ * \param pCmd pointer to the valid command (dense attribute arrays)
+ * \param pDesc pointer to the command descriptor
+ * \return int: -1 if operation fail, blob size if success
+ */
+int LCSF_ValidCmdGetDetachSize(const lcsf_valid_cmd_t *pCmd, const lcsf_command_desc_t *pDesc);
+
+/**
+ * \fn int LCSF_ValidCmdDetach(const lcsf_valid_cmd_t *pCmd, const lcsf_command_desc_t *pDesc, uint8_t *pOut, size_t outSize)
+ * \brief Copy a valid command, its attribute arrays and its payload bytes into a single relocatable blob
+ *
+ * The blob doesn't reference the receiver lifo or the receive buffer anymore, it can be copied or queued as is.
+ *
+ * \param pCmd pointer to the valid command (dense attribute arrays)
+ * \param pDesc pointer to the command descriptor
+ * \param pOut pointer to the blob buffer (pointer aligned)
+ * \param outSize blob buffer size
+ * \return int: -1 if operation fail, blob size if success
+ */
+int LCSF_ValidCmdDetach(const lcsf_valid_cmd_t *pCmd, const lcsf_command_desc_t *pDesc, uint8_t *pOut, size_t outSize);
+
+/**
+ * \fn bool LCSF_ValidCmdAttach(uint8_t *pBlob, size_t blobSize, const lcsf_command_desc_t *pDesc, lcsf_valid_cmd_t *pCmd)
+ * \brief Check a detached command blob then turn its offsets into pointers in place, to use it as a valid command
+ *
+ * Once attached, the blob can't be moved or attached again.
+ *
+ * \param pBlob pointer to the blob (pointer aligned)
+ * \param blobSize blob size
+ * \param pDesc pointer to the command descriptor
+ * \param pCmd pointer to contain the valid command
+ * \return bool: true if operation was a success
+ */
+bool LCSF_ValidCmdAttach(uint8_t *pBlob, size_t blobSize, const lcsf_command_desc_t *pDesc, lcsf_valid_cmd_t *pCmd);
+
+// *** End Definitions ***
+#endif // _LCSF_ValidCmd_h
@@ -71,6 +71,28 @@ typedef struct _lcsf_protocol_desc {
     const lcsf_command_desc_t *pCmdDescArray; /**< Pointer to the command descriptor table */
 } lcsf_protocol_desc_t; // total: 8 bytes, 2 padding
 
+/** Lcsf packed attribute descriptor record, sub-attributes are referenced by index */
+typedef struct _lcsf_packed_att_desc {
+    uint16_t AttIdOpt; /**< Attribute identifier and optional flag, see LCSF_PACKED_ATT_ID and LCSF_PACKED_ATT_IS_OPT */
+    uint8_t DataType; /**< Attribute data type */
+    uint8_t SubAttNb; /**< Number of sub-attributes */
+    uint16_t SubAttIdx; /**< Index of the first sub-attribute record */
+} lcsf_packed_att_desc_t; // total: 6 bytes, 0 padding
+
+/** Lcsf packed command descriptor record */
+typedef struct _lcsf_packed_cmd_desc {
+    uint16_t CmdId; /**< Command identifier */
+    uint16_t AttNb; /**< Number of possible attributes */
+    uint16_t AttIdx; /**< Index of the first attribute record */
+} lcsf_packed_cmd_desc_t; // total: 6 bytes, 0 padding
+
+/** Lcsf packed protocol descriptor structure, each attribute level is contiguous in the record array */
+typedef struct _lcsf_packed_prot_desc {
+    uint16_t CmdNb; /**< Number of possible commands */
+    const lcsf_packed_cmd_desc_t *pCmdArray; /**< Pointer to the command record table */
+    const lcsf_packed_att_desc_t *pAttArray; /**< Pointer to the attribute record table */
+} lcsf_packed_prot_desc_t; // total: 12 bytes, 2 padding
+
 // Lcsf valid types
 
 // Forward declaration to resolve cross-referencing
@@ -107,12 +129,64 @@ typedef struct _lcsf_validator_protocol_desc {
     uint16_t ProtVer; /**< Protocol version */
     const lcsf_protocol_desc_t *pProtDesc; /**< Pointer to protocol descriptor */
     LCSFInterpretCallback_t *pFnInterpretMsg; /**< Pointer to the message interpretation function */
-} lcsf_validator_protocol_desc_t; // total: 12 bytes, 0 padding
+    bool IsSparse; /**< Indicates if received commands use sparse attribute arrays, see LCSF_ValidatorGetSparseAtt */
+    const lcsf_packed_prot_desc_t *pPackedDesc; /**< Pointer to packed protocol descriptor, used if pProtDesc is NULL */
+    LCSFInterpretCallback_t *const *pFnCmdHandlerArray; /**< Optional command handlers in descriptor command order,
+                                                           NULL entries fall back to pFnInterpretMsg */
+} lcsf_validator_protocol_desc_t; // total: 24 bytes, 3 padding
+
+/** Protocol descriptor worst-case resource usage structure */
+typedef struct _lcsf_desc_usage {
+    uint16_t TranscoderRxItemNb; /**< Worst-case item number of the transcoder receive lifo */
+    uint16_t ValidatorRxItemNb; /**< Worst-case item number of the validator receive lifo */
+    uint16_t ValidatorTxItemNb; /**< Worst-case item number of the validator transmit lifo */
+    uint16_t BridgeItemNb; /**< Worst-case item number of the protocol bridge lifo */
+    uint16_t MaxDepth; /**< Maximum attribute nesting depth (number of nested recursive calls) */
+} lcsf_desc_usage_t; // total: 10 bytes, 0 padding
+
+/** Prepared attribute structure, one entry per encoded attribute in message order */
+typedef struct _lcsf_prepared_att {
+    uint16_t AttId:15; /**< Attribute identifier */
+    uint16_t HasSubAtt:1; /**< Indicates if the attribute has sub attributes or data */
+    uint16_t PayloadSize; /**< Data size (bytes) or sub attribute number */
+    uint16_t Offset; /**< Data index in the encoded message, unused with sub attributes */
+} lcsf_prepared_att_t; // total: 6 bytes, 0 padding
+
+/** Prepared command structure */
+typedef struct _lcsf_prepared_cmd {
+    uint8_t *pBuffer; /**< Pointer to the encoded message */
+    uint16_t MsgSize; /**< Encoded message size */
+    uint16_t ValuesSize; /**< Size of the values passed to LCSF_ValidatorExecute, the data of all the attributes */
+    uint16_t AttNb; /**< Number of entries in the prepared attribute array */
+    lcsf_prepared_att_t *pAttArray; /**< Pointer to the prepared attribute array */
+} lcsf_prepared_cmd_t; // total: 16 bytes, 2 padding
+
+/** Shape cache statistics structure */
+typedef struct _lcsf_shape_cache_stats {
+    uint32_t HitNb; /**< Number of messages validated from a memoized shape */
+    uint32_t MissNb; /**< Number of messages validated through the descriptor look ups */
+} lcsf_shape_cache_stats_t; // total: 8 bytes, 0 padding
 
 // Functions used by transcoder to send errors
-bool LCSF_ValidatorSendTranscoderError(uint_fast8_t errorType);
+bool LCSF_ValidatorSendTranscoderError(uint_fast8_t errorType, lcsf_repr_t repr);
+// Functions used by transcoder to reject messages before decoding their attributes
+lcsf_receive_status_t LCSF_ValidatorCheckHeader(const lcsf_raw_msg_t *pMessage, lcsf_repr_t repr);
+// Functions used by transcoder to receive fixed layout commands without decoding their attributes
+bool LCSF_ValidatorReceiveFixed(const lcsf_raw_msg_t *pMessage, const uint8_t *pBuffer, size_t buffSize,
+    lcsf_repr_t repr, lcsf_receive_status_t *pStatus);
 
 // --- Public Constants ---
+#define LCSF_PACKED_ATT_ID_MASK 0x7FFF /**< Attribute identifier bits of a packed attribute record */
+#define LCSF_PACKED_ATT_OPT_SHIFT 15 /**< Optional flag bit of a packed attribute record */
+
+/** Read the attribute identifier of a packed attribute record */
+#define LCSF_PACKED_ATT_ID(pRecord) ((uint16_t)((pRecord)->AttIdOpt & LCSF_PACKED_ATT_ID_MASK))
+/** Read the optional flag of a packed attribute record */
+#define LCSF_PACKED_ATT_IS_OPT(pRecord) ((((pRecord)->AttIdOpt >> LCSF_PACKED_ATT_OPT_SHIFT) & 1) != 0)
+/** Compute the identifier and optional flag field of a packed attribute record */
+#define LCSF_PACKED_ATT_ID_OPT(attId, isOptional)                                                                      \
+    ((uint16_t)(((attId) & LCSF_PACKED_ATT_ID_MASK) | ((uint16_t)((isOptional) ? 1 : 0) << LCSF_PACKED_ATT_OPT_SHIFT)))
+
 // --- Public Variables ---
 // --- Public Function Prototypes ---
 
@@ -130,21 +204,98 @@ bool LCSF_ValidatorInit(LCSFSendErrCallback_t *pFnSendErrCb, LCSFReceiveErrCallb
  * \fn bool LCSF_ValidatorAddProtocol(uint_fast16_t protId, const lcsf_validator_protocol_desc_t *pProtDesc)
  * \brief Add a protocol to the module table
  *
+ * The table is published as a new snapshot, receivers and encoders in progress keep the previous one. Messages are
+ * received and encoded from a single context, the table can be updated from another one.
+ * Fails until LCSF_ValidatorIsRegistrySynced confirms the previous update, updates come from a single writer.
+ *
  * \param protIdx protocol index in the module table
  * \param pProtDesc pointer to protocol descriptor
  * \return bool: true if operation was a success
  */
 bool LCSF_ValidatorAddProtocol(uint_fast16_t protIdx, const lcsf_validator_protocol_desc_t *pProtDesc);
 
+/**
+ * \fn bool LCSF_ValidatorSetCmdFilter(uint_fast16_t protIdx, const uint8_t *pCmdIdBitmap, size_t cmdIdNb)
+ * \brief Subscribe a protocol of the module table to a set of commands, the others are dropped without decoding
+ *
+ * \param protIdx protocol index in the module table
+ * \param pCmdIdBitmap pointer to the command id bitmap, bit n (byte n / 8, bit n % 8) set to receive command id n,
+ * NULL to receive all the commands
+ * \param cmdIdNb number of command ids in the bitmap, higher command ids are dropped
+ * \return bool: true if operation was a success
+ */
+bool LCSF_ValidatorSetCmdFilter(uint_fast16_t protIdx, const uint8_t *pCmdIdBitmap, size_t cmdIdNb);
+
+/**
+ * \fn bool LCSF_ValidatorSetTrusted(uint_fast16_t protIdx, bool isTrusted)
+ * \brief Set if a protocol of the module table is received from a trusted link (e.g. same build, CRC protected)
+ *
+ * Trusted messages are mapped to the descriptor by position, without attribute id look ups. A message out of the
+ * descriptor order or with a wrong payload size goes through the full validation. Sparse and packed protocols are always fully validated.
+ *
+ * \param protIdx protocol index in the module table
+ * \param isTrusted true to map received messages by position first
+ * \return bool: true if operation was a success
+ */
+bool LCSF_ValidatorSetTrusted(uint_fast16_t protIdx, bool isTrusted);
+
+/**
+ * \fn bool LCSF_ValidatorHoldCmd(uint_fast16_t *pGenIdx)
+ * \brief Keep the attribute arrays of the command being interpreted after its interpretation function returns
+ *
+ * To be called from an interpretation function, needs LCSF_VALIDATOR_RX_GEN_NB > 1. The next messages use the other
+ * receiver lifo generations, they are dropped while all of them are held. Attribute data still points into the
+ * receive buffer, see LCSF_RxRing to hold it as well.
+ *
+ * \param pGenIdx pointer to contain the held generation index
+ * \return bool: true if operation was a success
+ */
+bool LCSF_ValidatorHoldCmd(uint_fast16_t *pGenIdx);
+
+/**
+ * \fn bool LCSF_ValidatorReleaseCmd(uint_fast16_t genIdx)
+ * \brief Release a command held by LCSF_ValidatorHoldCmd, can be called from another context than the receiver
+ *
+ * \param genIdx held generation index
+ * \return bool: true if operation was a success
+ */
+bool LCSF_ValidatorReleaseCmd(uint_fast16_t genIdx);
+
+/**
+ * \fn bool LCSF_ValidatorIsRegistrySynced(void)
+ * \brief Indicate if the readers released the protocol table snapshot replaced by the last update
+ *
+ * Descriptors and filters replaced by the last LCSF_ValidatorAddProtocol, LCSF_ValidatorSetCmdFilter or
+ * LCSF_ValidatorSetTrusted call can be reclaimed once it returns true.
+ *
+ * \return bool: true if no reader holds the replaced snapshot anymore
+ */
+bool LCSF_ValidatorIsRegistrySynced(void);
+
 /**
  * \fn bool LCSF_ValidatorReceive(const lcsf_raw_msg_t *pMessage)
  * \brief Validate a raw lcsf message and send to interpreter
  *
+ * Can be called from an interpretation function, the nested message uses another receiver lifo generation and is
+ * dropped if none is available.
+ *
  * \param pMessage Pointer to message to validate
  * \return lcsf_receive_status_t: LCSF_RECEIVE_OK if processed, otherwise the matching LCSF_RECEIVE_* error status
  */
 lcsf_receive_status_t LCSF_ValidatorReceive(const lcsf_raw_msg_t *pMessage);
 
+/**
+ * \fn lcsf_receive_status_t LCSF_ValidatorReceiveRepr(const lcsf_raw_msg_t *pMessage, lcsf_repr_t repr)
+ * \brief Validate a raw lcsf message received in a given representation and send to interpreter
+ *
+ * The errors and the messages sent from the interpretation function use the same representation.
+ *
+ * \param pMessage Pointer to message to validate
+ * \param repr representation the message was received in
+ * \return lcsf_receive_status_t: LCSF_RECEIVE_OK if processed, otherwise the matching LCSF_RECEIVE_* error status
+ */
+lcsf_receive_status_t LCSF_ValidatorReceiveRepr(const lcsf_raw_msg_t *pMessage, lcsf_repr_t repr);
+
 /**
  * \fn int LCSF_ValidatorEncode(uint_fast16_t protId, lcsf_valid_cmd_t *pCommand)
  * \brief Send a valid command to lcsf transcoder for encoding
@@ -157,5 +308,103 @@ lcsf_receive_status_t LCSF_ValidatorReceive(const lcsf_raw_msg_t *pMessage);
  */
 int LCSF_ValidatorEncode(uint_fast16_t protId, const lcsf_valid_cmd_t *pCommand, uint8_t *pBuffer, size_t buffSize);
 
+/**
+ * \fn bool LCSF_ValidatorPrepare(uint_fast16_t protId, const lcsf_valid_cmd_t *pCommand, uint8_t *pBuffer, size_t buffSize, lcsf_prepared_att_t *pAttArray, size_t attArraySize, lcsf_prepared_cmd_t *pPrepared)
+ * \brief Validate and encode a command once, noting where each attribute data lies in the encoded message
+ *
+ * \param protId protocol identifier
+ * \param pCommand pointer to the command to prepare
+ * \param pBuffer pointer to the send buffer, kept by the prepared command
+ * \param buffSize buffer size
+ * \param pAttArray pointer to the prepared attribute array, one entry per encoded attribute
+ * \param attArraySize prepared attribute array size
+ * \param pPrepared pointer to contain the prepared command
+ * \return bool: true if operation was a success
+ */
+bool LCSF_ValidatorPrepare(uint_fast16_t protId, const lcsf_valid_cmd_t *pCommand, uint8_t *pBuffer, size_t buffSize,
+    lcsf_prepared_att_t *pAttArray, size_t attArraySize, lcsf_prepared_cmd_t *pPrepared);
+
+/**
+ * \fn int LCSF_ValidatorExecute(const lcsf_prepared_cmd_t *pPrepared, const uint8_t *pValues, size_t valuesSize)
+ * \brief Rewrite the data of a prepared command in place
+ *
+ * The values are the data of the prepared attributes, sub-attributes excepted, following each other in the
+ * prepared attribute array order with their prepared size (strings include their null terminator).
+ *
+ * \param pPrepared pointer to the prepared command
+ * \param pValues pointer to the new values
+ * \param valuesSize size of the new values, must match the prepared command ValuesSize
+ * \return int: -1 if operation failed, encoded message size if success
+ */
+int LCSF_ValidatorExecute(const lcsf_prepared_cmd_t *pPrepared, const uint8_t *pValues, size_t valuesSize);
+
+/**
+ * \fn int LCSF_ValidatorExecuteCopy(const lcsf_prepared_cmd_t *pPrepared, const uint8_t *pValues, size_t valuesSize, uint8_t *pBuffer, size_t buffSize)
+ * \brief Copy a prepared command into a buffer and write its data there, the prepared message is left unchanged
+ *
+ * Constant and near-constant messages (e.g. acknowledgments) can be prepared once at init as read-only templates,
+ * then sent from any context with only a copy and the patch of their values.
+ *
+ * \param pPrepared pointer to the prepared command
+ * \param pValues pointer to the values, laid out as for LCSF_ValidatorExecute
+ * \param valuesSize size of the values, must match the prepared command ValuesSize
+ * \param pBuffer pointer to the send buffer
+ * \param buffSize buffer size
+ * \return int: -1 if operation failed, encoded message size if success
+ */
+int LCSF_ValidatorExecuteCopy(const lcsf_prepared_cmd_t *pPrepared, const uint8_t *pValues, size_t valuesSize,
+    uint8_t *pBuffer, size_t buffSize);
+
+/**
+ * \fn bool LCSF_ValidatorPackDesc(const lcsf_protocol_desc_t *pProtDesc, lcsf_packed_cmd_desc_t *pCmdArray, size_t cmdArraySize, lcsf_packed_att_desc_t *pAttArray, size_t attArraySize, lcsf_packed_prot_desc_t *pPackedDesc)
+ * \brief Convert a protocol descriptor into packed records (e.g. to generate a constant packed descriptor)
+ *
+ * \param pProtDesc pointer to the protocol descriptor
+ * \param pCmdArray pointer to contain the command records
+ * \param cmdArraySize number of command records the array can hold
+ * \param pAttArray pointer to contain the attribute records
+ * \param attArraySize number of attribute records the array can hold
+ * \param pPackedDesc pointer to contain the packed protocol descriptor
+ * \return bool: true if operation was a success
+ */
+bool LCSF_ValidatorPackDesc(const lcsf_protocol_desc_t *pProtDesc, lcsf_packed_cmd_desc_t *pCmdArray,
+    size_t cmdArraySize, lcsf_packed_att_desc_t *pAttArray, size_t attArraySize, lcsf_packed_prot_desc_t *pPackedDesc);
+
+/**
+ * \fn lcsf_valid_att_t *LCSF_ValidatorGetSparseAtt(const lcsf_valid_att_t *pAttArray, uint_fast16_t descAttNb, uint_fast16_t descIdx)
+ * \brief Retrieve an attribute from a sparse attribute array, received with a sparse protocol
+ *
+ * A sparse array starts with a presence bitmap region (one word per 32 descriptor attributes, rounded up to whole
+ * items) followed by the present attributes only, in descriptor order. The region is only read through this function.
+ *
+ * \param pAttArray pointer to the sparse attribute array
+ * \param descAttNb number of attributes in the descriptor array
+ * \param descIdx index of the attribute in the descriptor array
+ * \return lcsf_valid_att_t *: pointer to the attribute, NULL if absent
+ */
+lcsf_valid_att_t *LCSF_ValidatorGetSparseAtt(
+    const lcsf_valid_att_t *pAttArray, uint_fast16_t descAttNb, uint_fast16_t descIdx);
+
+/**
+ * \fn bool LCSF_ValidatorGetShapeCacheStats(lcsf_shape_cache_stats_t *pStats)
+ * \brief Retrieve the shape cache hit and miss numbers since the module initialization
+ *
+ * \param pStats pointer to contain the statistics
+ * \return bool: true if operation was a success, false if the shape cache is disabled
+ */
+bool LCSF_ValidatorGetShapeCacheStats(lcsf_shape_cache_stats_t *pStats);
+
+/**
+ * \fn bool LCSF_ValidatorGetDescUsage(const lcsf_protocol_desc_t *pProtDesc, lcsf_desc_usage_t *pUsage)
+ * \brief Compute the worst-case lifo item numbers and nesting depth of a protocol descriptor
+ *
+ * The transcoder and validator lifos are shared between protocols, size them with the maximum over all the protocols.
+ *
+ * \param pProtDesc pointer to the protocol descriptor
+ * \param pUsage pointer to contain the resource usage
+ * \return bool: true if operation was a success
+ */
+bool LCSF_ValidatorGetDescUsage(const lcsf_protocol_desc_t *pProtDesc, lcsf_desc_usage_t *pUsage);
+
 // *** End Definitions ***
 #endif // _LCSF_Interpreter_h
\ No newline at end of file
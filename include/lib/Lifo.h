@@ -30,16 +30,36 @@
 // *** Definitions ***
 // --- Public Types ---
 
+// Allocator callback prototypes
+typedef void *(LifoAllocGetCallback_t)(void *pUser, size_t size);
+typedef void(LifoAllocFreeAllCallback_t)(void *pUser);
+
+/** Lifo allocator structure */
+typedef struct _lifo_allocator {
+    LifoAllocGetCallback_t *pFnGet; /**< Function pointer to allocate memory, returns NULL if out of memory */
+    LifoAllocFreeAllCallback_t *pFnFreeAll; /**< Function pointer to free all the allocated memory */
+    void *pUser; /**< User pointer passed to the callbacks */
+} lifo_allocator_t; // total: 12 bytes, 0 padding
+
 /** Lifo descriptor structure */
 typedef struct _lifo_desc {
     uint16_t ItemSize; /**< Size of the lifo item */
     uint16_t ItemNb; /**< Number of lifo items */
     uint16_t FreeItemNb; /**< Number of free lifo space (item number) */
+    uint16_t ArenaMark; /**< Arena taken item number at the region first allocation (region lifo only) */
     void *pDataArray; /**< Pointer to the lifo data array */
-} lifo_desc_t; // total: 12 bytes, 2 padding
+    struct _lifo_desc *pArena; /**< Pointer to the backing arena lifo (region lifo only), NULL otherwise */
+    const lifo_allocator_t *pAllocator; /**< Pointer to the backing allocator (allocator lifo only), NULL otherwise */
+} lifo_desc_t; // total: 20 bytes, 0 padding
 
 // --- Public Constants ---
 // --- Public Variables ---
+
+#ifdef LCSF_SHARED_ARENA
+/** Arena backing all the lcsf stack lifos, initialize it with LifoInit or LifoInitAllocator before using the stack */
+extern lifo_desc_t LcsfSharedArena;
+#endif
+
 // --- Public Function Prototypes ---
 
 /**
@@ -54,6 +74,34 @@ typedef struct _lifo_desc {
  */
 bool LifoInit(lifo_desc_t *pLifo, void *pBuffer, size_t itemNb, size_t itemSize);
 
+/**
+ * \fn bool LifoInitAllocator(lifo_desc_t *pLifo, const lifo_allocator_t *pAllocator, size_t itemSize)
+ * \brief Initialize a lifo backed by an allocator instead of a fixed buffer
+ *
+ * The allocator free all callback is called once every item of the lifo has been freed.
+ *
+ * \param pLifo: pointer to the lifo
+ * \param pAllocator: pointer to the allocator (must stay valid while the lifo is used)
+ * \param itemSize size of each item
+ * \return bool: true if operation was a success
+ */
+bool LifoInitAllocator(lifo_desc_t *pLifo, const lifo_allocator_t *pAllocator, size_t itemSize);
+
+/**
+ * \fn bool LifoInitRegion(lifo_desc_t *pLifo, lifo_desc_t *pArena, size_t itemSize)
+ * \brief Initialize a lifo as a region stacked on top of an arena lifo
+ *
+ * Region allocations are rounded up to arena items, whose size must be a multiple of the region items alignment.
+ * Freeing a region releases the arena down to the region first allocation, so regions sharing an arena must be
+ * freed in the reverse order of their first allocation. LifoFree is not supported on regions.
+ *
+ * \param pLifo: pointer to the lifo
+ * \param pArena: pointer to the arena lifo (can be initialized later, before the first allocation)
+ * \param itemSize size of each item
+ * \return bool: true if operation was a success
+ */
+bool LifoInitRegion(lifo_desc_t *pLifo, lifo_desc_t *pArena, size_t itemSize);
+
 /**
  * \fn bool LifoGet(lifo_desc_t *pLifoDesc, size_t slotNumber, void **pFreeSlot)
  * \brief Allocate a table of item from a lifo and return the pointer
@@ -32,7 +32,7 @@
 // *** Definitions ***
 // --- Public Types ---
 
-#define LCSF_EXAMPLE_BRIDGE_LIFO_SIZE 5 // Max number of attributes
+#define LCSF_EXAMPLE_BRIDGE_LIFO_SIZE 8 // Max number of attributes
 
 // Lcsf example protocol identifier
 #define LCSF_EXAMPLE_PROTOCOL_ID 0x00
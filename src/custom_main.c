@@ -48,6 +48,12 @@ static bool dummyErrSend(const uint8_t *pBuffer, size_t buffSize) {
 }
 
 // --- LCSF Stack ---
+#ifdef LCSF_SHARED_ARENA
+// Shared arena, size it with the lcsf_stack_sizing tool
+#define APP_ARENA_ITEM_NB 32
+static lcsf_valid_att_t AppArenaData[APP_ARENA_ITEM_NB];
+#endif
+
 enum lcsf_validator_protocol_enum {
     LCSF_PROTOCOL_EXAMPLE = 0,
     LCSF_PROTOCOL_COUNT,
@@ -58,6 +64,9 @@ static const lcsf_validator_protocol_desc_t LcsfProtocolExampleDesc = {
     LCSF_EXAMPLE_PROTOCOL_VERSION,
     &LCSF_Example_ProtDesc,
     LCSF_Bridge_ExampleReceive,
+    false,
+    NULL,
+    NULL,
 };
 
 // --- LCSF Example ---
@@ -79,6 +88,9 @@ static const example_init_desc_t ExampleMainInitDesc = {
  */
 static void app_init(void) {
     // Lcsf stack
+#ifdef LCSF_SHARED_ARENA
+    LifoInit(&LcsfSharedArena, AppArenaData, APP_ARENA_ITEM_NB, sizeof(lcsf_valid_att_t));
+#endif
     LCSF_TranscoderInit();
     LCSF_ValidatorInit(&dummyErrSend, NULL);
     LCSF_ValidatorAddProtocol(LCSF_PROTOCOL_EXAMPLE, &LcsfProtocolExampleDesc);
@@ -0,0 +1,149 @@
+/**
+ * \file ChunkArena.c
+ * \brief Growable chained-chunk arena module, lifo allocator for hosted builds
+ * \author Jean-Roland Gosse
+ *
+ * This file is part of LCSF C Stack.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ */
+
+// *** Libraries include ***
+// Standard lib
+#include <stdlib.h>
+#include <string.h>
+// Custom lib
+#include <LCSF_Config.h>
+#include <lib/ChunkArena.h>
+
+// *** Definitions ***
+// --- Private Types ---
+
+// Allocation alignment (bytes)
+#define CHUNK_ARENA_ALIGN 8
+
+// Chunk structure, data follows the header
+struct _chunk_arena_chunk {
+    chunk_arena_chunk_t *pNext; // Pointer to the next chunk of the chain
+    size_t DataSize; // Chunk data size (bytes)
+    uint64_t Data[]; // Chunk data
+};
+
+// --- Private Constants ---
+// --- Private Function Prototypes ---
+static chunk_arena_chunk_t *ChunkArenaNewChunk(size_t dataSize, chunk_arena_chunk_t *pNext);
+
+// --- Private Variables ---
+// *** End Definitions ***
+
+// *** Private Functions ***
+
+/**
+ * \fn static chunk_arena_chunk_t *ChunkArenaNewChunk(size_t dataSize, chunk_arena_chunk_t *pNext)
+ * \brief Allocate a new chunk
+ *
+ * \param dataSize chunk data size (bytes)
+ * \param pNext pointer to the next chunk of the chain
+ * \return chunk_arena_chunk_t *: pointer to the chunk, NULL if out of memory
+ */
+static chunk_arena_chunk_t *ChunkArenaNewChunk(size_t dataSize, chunk_arena_chunk_t *pNext) {
+    chunk_arena_chunk_t *pChunk = malloc(sizeof(chunk_arena_chunk_t) + dataSize);
+    if (pChunk == NULL) {
+        return NULL;
+    }
+    pChunk->pNext = pNext;
+    pChunk->DataSize = dataSize;
+    return pChunk;
+}
+
+// *** Public Functions ***
+
+bool ChunkArenaInit(chunk_arena_t *pArena, size_t chunkSize, lifo_allocator_t *pAllocator) {
+    // Bad parameters guard
+    if ((pArena == NULL) || (chunkSize == 0)) {
+        return false;
+    }
+    // Arena initialization
+    memset(pArena, 0, sizeof(chunk_arena_t));
+    pArena->ChunkSize = chunkSize;
+    // Allocator initialization
+    if (pAllocator != NULL) {
+        pAllocator->pFnGet = ChunkArenaGet;
+        pAllocator->pFnFreeAll = ChunkArenaFreeAll;
+        pAllocator->pUser = pArena;
+    }
+    return true;
+}
+
+void *ChunkArenaGet(void *pArena, size_t size) {
+    chunk_arena_t *pChunkArena = (chunk_arena_t *)pArena;
+    // Bad parameters guard
+    if (pChunkArena == NULL) {
+        return NULL;
+    }
+    // Round size up to alignment
+    size = (size + CHUNK_ARENA_ALIGN - 1) & ~((size_t)CHUNK_ARENA_ALIGN - 1);
+    chunk_arena_chunk_t *pChunk = pChunkArena->pCurrChunk;
+    // Check current chunk space
+    if ((pChunk == NULL) || ((pChunk->DataSize - pChunkArena->ChunkOffset) < size)) {
+        // Recycle the next chunk if large enough, otherwise chain a new one in front of it
+        chunk_arena_chunk_t *pNext = (pChunk == NULL) ? pChunkArena->pFirstChunk : pChunk->pNext;
+        if ((pNext == NULL) || (pNext->DataSize < size)) {
+            pNext = ChunkArenaNewChunk((size > pChunkArena->ChunkSize) ? size : pChunkArena->ChunkSize, pNext);
+            if (pNext == NULL) {
+                return NULL;
+            }
+            if (pChunk == NULL) {
+                pChunkArena->pFirstChunk = pNext;
+            } else {
+                pChunk->pNext = pNext;
+            }
+        }
+        pChunkArena->pCurrChunk = pNext;
+        pChunkArena->ChunkOffset = 0;
+        pChunk = pNext;
+    }
+    // Allocate from current chunk
+    void *pMem = (uint8_t *)pChunk->Data + pChunkArena->ChunkOffset;
+    pChunkArena->ChunkOffset += size;
+    return pMem;
+}
+
+void ChunkArenaFreeAll(void *pArena) {
+    chunk_arena_t *pChunkArena = (chunk_arena_t *)pArena;
+    // Bad parameters guard
+    if (pChunkArena == NULL) {
+        return;
+    }
+    // Rewind to the first chunk
+    pChunkArena->pCurrChunk = NULL;
+    pChunkArena->ChunkOffset = 0;
+}
+
+void ChunkArenaRelease(chunk_arena_t *pArena) {
+    // Bad parameters guard
+    if (pArena == NULL) {
+        return;
+    }
+    // Free the chunk chain
+    chunk_arena_chunk_t *pChunk = pArena->pFirstChunk;
+    while (pChunk != NULL) {
+        chunk_arena_chunk_t *pNext = pChunk->pNext;
+        free(pChunk);
+        pChunk = pNext;
+    }
+    pArena->pFirstChunk = NULL;
+    pArena->pCurrChunk = NULL;
+    pArena->ChunkOffset = 0;
+}
@@ -0,0 +1,247 @@
+/**
+ * \file LCSF_Builder.c
+ * \brief Light Command Set Format message builder module, encodes attributes straight into the send buffer
+ * \author Jean-Roland Gosse
+ *
+ * This file is part of LCSF C Stack.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ */
+
+// *** Libraries include ***
+// Standard lib
+#include <string.h>
+// Custom lib
+#include <LCSF_Config.h>
+#include <lib/LCSF_Builder.h>
+#include <lib/Lifo.h>
+
+// *** Definitions ***
+// --- Private Types ---
+// --- Private Constants ---
+// --- Private Function Prototypes ---
+static bool LCSF_BuilderAddAttHeader(lcsf_builder_t *pBuilder, uint_fast16_t attId, bool hasSubAtt, size_t payloadSize);
+static void LCSF_BuilderPatchCount(lcsf_builder_t *pBuilder, size_t countIdx, uint_fast16_t count);
+
+// --- Private Variables ---
+// *** End Definitions ***
+
+// *** Private Functions ***
+
+/**
+ * \fn static bool LCSF_BuilderAddAttHeader(lcsf_builder_t *pBuilder, uint_fast16_t attId, bool hasSubAtt, size_t payloadSize)
+ * \brief Write an attribute header at the builder position and count it in the current level
+ *
+ * \param pBuilder pointer to the builder
+ * \param attId attribute identifier
+ * \param hasSubAtt indicates if the attribute has sub-attributes
+ * \param payloadSize attribute data size (sub-attribute number is patched later)
+ * \return bool: true if operation was a success
+ */
+static bool LCSF_BuilderAddAttHeader(lcsf_builder_t *pBuilder, uint_fast16_t attId, bool hasSubAtt, size_t payloadSize) {
+    bool isSmall = (pBuilder->Repr == LCSF_REPR_SMALL);
+    size_t attHeaderSize = isSmall ? 2 : 4;
+    uint_fast16_t maxAttId = isSmall ? 0x7F : 0x7FFF;
+    uint_fast16_t maxCount = isSmall ? 0xFF : 0xFFFF;
+    uint8_t *pHeader;
+
+    // Representation limits guard
+    if ((attId > maxAttId) || (payloadSize > maxCount) || (pBuilder->AttNbArray[pBuilder->Depth] >= maxCount)) {
+        return false;
+    }
+    // Buffer overflow guard
+    if ((pBuilder->BuffIdx + attHeaderSize + payloadSize) > pBuilder->BuffSize) {
+        return false;
+    }
+    pHeader = &(pBuilder->pBuffer[pBuilder->BuffIdx]);
+    if (isSmall) {
+        // Byte 1: Attribute id + complexity flag (MSb)
+        pHeader[0] = (uint8_t)(attId | (hasSubAtt ? 0x80 : 0x00));
+        // Byte 2: Data size or sub-attribute number
+        pHeader[1] = (uint8_t)payloadSize;
+    } else {
+        // Bytes 1-2: Attribute id + complexity flag (MSb)
+        pHeader[0] = (uint8_t)attId;
+        pHeader[1] = (uint8_t)((attId >> 8) | (hasSubAtt ? 0x80 : 0x00));
+        // Bytes 3-4: Data size or sub-attribute number
+        pHeader[2] = (uint8_t)payloadSize;
+        pHeader[3] = (uint8_t)(payloadSize >> 8);
+    }
+    pBuilder->BuffIdx += attHeaderSize;
+    pBuilder->AttNbArray[pBuilder->Depth]++;
+    return true;
+}
+
+/**
+ * \fn static void LCSF_BuilderPatchCount(lcsf_builder_t *pBuilder, size_t countIdx, uint_fast16_t count)
+ * \brief Patch an attribute number field of the message or of a group header
+ *
+ * \param pBuilder pointer to the builder
+ * \param countIdx index of the field
+ * \param count attribute number
+ * \return void
+ */
+static void LCSF_BuilderPatchCount(lcsf_builder_t *pBuilder, size_t countIdx, uint_fast16_t count) {
+    pBuilder->pBuffer[countIdx] = (uint8_t)count;
+    if (pBuilder->Repr != LCSF_REPR_SMALL) {
+        pBuilder->pBuffer[countIdx + 1] = (uint8_t)(count >> 8);
+    }
+}
+
+// *** Public Functions ***
+
+bool LCSF_BuilderBeginMsg(lcsf_builder_t *pBuilder, uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr,
+    uint_fast16_t protId, uint_fast16_t protVer, uint_fast16_t cmdId) {
+    // Bad parameters guard
+    if ((pBuilder == NULL) || (pBuffer == NULL)) {
+        return false;
+    }
+    pBuilder->HasError = true;
+    if (repr == LCSF_REPR_SMALL) {
+        // Representation limits and buffer overflow guards
+        if ((protId > 0xFF) || (protVer > 0xFF) || (cmdId > 0xFF) || (buffSize < 4)) {
+            return false;
+        }
+        pBuffer[0] = (uint8_t)protId;
+        pBuffer[1] = (uint8_t)protVer;
+        pBuffer[2] = (uint8_t)cmdId;
+        pBuffer[3] = 0;
+        pBuilder->CountIdxArray[0] = 3;
+        pBuilder->BuffIdx = 4;
+    } else if (repr == LCSF_REPR_STANDARD) {
+        // Buffer overflow guard
+        if (buffSize < 8) {
+            return false;
+        }
+        pBuffer[0] = (uint8_t)protId;
+        pBuffer[1] = (uint8_t)(protId >> 8);
+        pBuffer[2] = (uint8_t)protVer;
+        pBuffer[3] = (uint8_t)(protVer >> 8);
+        pBuffer[4] = (uint8_t)cmdId;
+        pBuffer[5] = (uint8_t)(cmdId >> 8);
+        pBuffer[6] = 0;
+        pBuffer[7] = 0;
+        pBuilder->CountIdxArray[0] = 6;
+        pBuilder->BuffIdx = 8;
+    } else {
+        return false;
+    }
+    // Builder initialization
+    pBuilder->pBuffer = pBuffer;
+    pBuilder->BuffSize = buffSize;
+    pBuilder->Repr = repr;
+    pBuilder->Depth = 0;
+    pBuilder->AttNbArray[0] = 0;
+    pBuilder->HasError = false;
+    return true;
+}
+
+bool LCSF_BuilderAddBytes(lcsf_builder_t *pBuilder, uint_fast16_t attId, const void *pData, size_t dataSize) {
+    // Bad parameters guard
+    if ((pBuilder == NULL) || pBuilder->HasError) {
+        return false;
+    }
+    if ((pData == NULL) && (dataSize > 0)) {
+        pBuilder->HasError = true;
+        return false;
+    }
+    // Write header then data
+    if (!LCSF_BuilderAddAttHeader(pBuilder, attId, false, dataSize)) {
+        pBuilder->HasError = true;
+        return false;
+    }
+    if (dataSize > 0) {
+        memcpy(&(pBuilder->pBuffer[pBuilder->BuffIdx]), pData, dataSize);
+        pBuilder->BuffIdx += dataSize;
+    }
+    return true;
+}
+
+bool LCSF_BuilderAddU8(lcsf_builder_t *pBuilder, uint_fast16_t attId, uint8_t value) {
+    return LCSF_BuilderAddBytes(pBuilder, attId, &value, sizeof(uint8_t));
+}
+
+bool LCSF_BuilderAddU16(lcsf_builder_t *pBuilder, uint_fast16_t attId, uint16_t value) {
+    return LCSF_BuilderAddBytes(pBuilder, attId, &value, sizeof(uint16_t));
+}
+
+bool LCSF_BuilderAddU32(lcsf_builder_t *pBuilder, uint_fast16_t attId, uint32_t value) {
+    return LCSF_BuilderAddBytes(pBuilder, attId, &value, sizeof(uint32_t));
+}
+
+bool LCSF_BuilderAddU64(lcsf_builder_t *pBuilder, uint_fast16_t attId, uint64_t value) {
+    return LCSF_BuilderAddBytes(pBuilder, attId, &value, sizeof(uint64_t));
+}
+
+bool LCSF_BuilderAddVle(lcsf_builder_t *pBuilder, uint_fast16_t attId, uint64_t value) {
+    return LCSF_BuilderAddBytes(pBuilder, attId, &value, GetVLESize(value));
+}
+
+bool LCSF_BuilderAddString(lcsf_builder_t *pBuilder, uint_fast16_t attId, const char *pString) {
+    // Bad parameters guard
+    if ((pBuilder == NULL) || (pString == NULL)) {
+        return false;
+    }
+    return LCSF_BuilderAddBytes(pBuilder, attId, pString, strlen(pString) + 1);
+}
+
+bool LCSF_BuilderBeginGroup(lcsf_builder_t *pBuilder, uint_fast16_t attId) {
+    // Bad parameters guard
+    if ((pBuilder == NULL) || pBuilder->HasError) {
+        return false;
+    }
+    // Max depth guard
+    if (pBuilder->Depth >= LCSF_BUILDER_MAX_DEPTH) {
+        pBuilder->HasError = true;
+        return false;
+    }
+    size_t headerIdx = pBuilder->BuffIdx;
+    // Write header, sub-attribute number is patched when the group ends
+    if (!LCSF_BuilderAddAttHeader(pBuilder, attId, true, 0)) {
+        pBuilder->HasError = true;
+        return false;
+    }
+    pBuilder->Depth++;
+    pBuilder->CountIdxArray[pBuilder->Depth] = headerIdx + ((pBuilder->Repr == LCSF_REPR_SMALL) ? 1 : 2);
+    pBuilder->AttNbArray[pBuilder->Depth] = 0;
+    return true;
+}
+
+bool LCSF_BuilderEndGroup(lcsf_builder_t *pBuilder) {
+    // Bad parameters guard
+    if ((pBuilder == NULL) || pBuilder->HasError) {
+        return false;
+    }
+    // Top level guard
+    if (pBuilder->Depth == 0) {
+        pBuilder->HasError = true;
+        return false;
+    }
+    LCSF_BuilderPatchCount(pBuilder, pBuilder->CountIdxArray[pBuilder->Depth], pBuilder->AttNbArray[pBuilder->Depth]);
+    pBuilder->Depth--;
+    return true;
+}
+
+int LCSF_BuilderEndMsg(lcsf_builder_t *pBuilder) {
+    // Bad parameters guard
+    if ((pBuilder == NULL) || pBuilder->HasError) {
+        return -1;
+    }
+    // Open group guard
+    if (pBuilder->Depth != 0) {
+        return -1;
+    }
+    LCSF_BuilderPatchCount(pBuilder, pBuilder->CountIdxArray[0], pBuilder->AttNbArray[0]);
+    return (int)pBuilder->BuffIdx;
+}
@@ -0,0 +1,278 @@
+/**
+ * \file LCSF_Cursor.c
+ * \brief Light Command Set Format attribute cursor module, reads attributes in place without attribute tree
+ * \author Jean-Roland Gosse
+ *
+ * This file is part of LCSF C Stack.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ */
+
+// *** Libraries include ***
+// Standard lib
+#include <string.h>
+// Custom lib
+#include <LCSF_Config.h>
+#include <lib/LCSF_Cursor.h>
+
+// *** Definitions ***
+// --- Private Types ---
+// --- Private Constants ---
+// --- Private Function Prototypes ---
+static bool LCSF_CursorReadAtt(lcsf_cursor_t *pCursor, lcsf_raw_att_t *pAtt);
+static bool LCSF_CursorSkip(lcsf_cursor_t *pCursor, uint32_t attNb);
+
+// --- Private Variables ---
+// *** End Definitions ***
+
+// *** Private Functions ***
+
+/**
+ * \fn static bool LCSF_CursorReadAtt(lcsf_cursor_t *pCursor, lcsf_raw_att_t *pAtt)
+ * \brief Read the attribute header at the cursor position and step over the attribute data
+ *
+ * \param pCursor pointer to the cursor
+ * \param pAtt pointer to contain the attribute
+ * \return bool: true if operation was a success
+ */
+static bool LCSF_CursorReadAtt(lcsf_cursor_t *pCursor, lcsf_raw_att_t *pAtt) {
+    const uint8_t *pBuffer = pCursor->pBuffer;
+    size_t idx = pCursor->BuffIdx;
+
+    if (pCursor->Repr == LCSF_REPR_SMALL) {
+        // Buffer overflow guard
+        if ((idx + 2) > pCursor->BuffSize) {
+            return false;
+        }
+        // Byte 1: Complexity flag (MSb) + attribute id
+        pAtt->HasSubAtt = ((pBuffer[idx] & 0x80) != 0);
+        pAtt->AttId = pBuffer[idx] & 0x7F;
+        // Byte 2: Data size or sub-attribute number
+        pAtt->PayloadSize = pBuffer[idx + 1];
+        idx += 2;
+    } else {
+        // Buffer overflow guard
+        if ((idx + 4) > pCursor->BuffSize) {
+            return false;
+        }
+        // Bytes 1-2: Attribute id + complexity flag (MSb)
+        pAtt->HasSubAtt = ((pBuffer[idx + 1] & 0x80) != 0);
+        pAtt->AttId = pBuffer[idx] + ((pBuffer[idx + 1] & 0x7F) << 8);
+        // Bytes 3-4: Data size or sub-attribute number
+        pAtt->PayloadSize = pBuffer[idx + 2] + (pBuffer[idx + 3] << 8);
+        idx += 4;
+    }
+    if (pAtt->HasSubAtt) {
+        // Sub-attributes follow the header
+        pAtt->Payload.pSubAttArray = NULL;
+    } else {
+        // Buffer overflow guard
+        if ((idx + pAtt->PayloadSize) > pCursor->BuffSize) {
+            return false;
+        }
+        pAtt->Payload.pData = (uint8_t *)&(pBuffer[idx]);
+        idx += pAtt->PayloadSize;
+    }
+    pCursor->BuffIdx = idx;
+    return true;
+}
+
+/**
+ * \fn static bool LCSF_CursorSkip(lcsf_cursor_t *pCursor, uint32_t attNb)
+ * \brief Skip attributes (and their sub-attributes) at the cursor position
+ *
+ * \param pCursor pointer to the cursor
+ * \param attNb number of attributes to skip
+ * \return bool: true if operation was a success
+ */
+static bool LCSF_CursorSkip(lcsf_cursor_t *pCursor, uint32_t attNb) {
+    lcsf_raw_att_t att;
+
+    while (attNb > 0) {
+        attNb--;
+        if (!LCSF_CursorReadAtt(pCursor, &att)) {
+            pCursor->HasError = true;
+            return false;
+        }
+        if (att.HasSubAtt) {
+            attNb += att.PayloadSize;
+        }
+    }
+    return true;
+}
+
+// *** Public Functions ***
+
+bool LCSF_CursorInit(
+    lcsf_cursor_t *pCursor, const uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr, lcsf_raw_msg_t *pHeader) {
+    lcsf_raw_msg_t header;
+    // Bad parameters guard
+    if ((pCursor == NULL) || (pBuffer == NULL)) {
+        return false;
+    }
+    if ((repr != LCSF_REPR_STANDARD) && (repr != LCSF_REPR_SMALL)) {
+        return false;
+    }
+    // Read message header
+    if (repr == LCSF_REPR_SMALL) {
+        if (buffSize < 4) {
+            return false;
+        }
+        header.ProtId = pBuffer[0];
+        header.ProtVer = pBuffer[1];
+        header.CmdId = pBuffer[2];
+        header.AttNb = pBuffer[3];
+        pCursor->BuffIdx = 4;
+    } else {
+        if (buffSize < 8) {
+            return false;
+        }
+        header.ProtId = pBuffer[0] + (pBuffer[1] << 8);
+        header.ProtVer = pBuffer[2] + (pBuffer[3] << 8);
+        header.CmdId = pBuffer[4] + (pBuffer[5] << 8);
+        header.AttNb = pBuffer[6] + (pBuffer[7] << 8);
+        pCursor->BuffIdx = 8;
+    }
+    header.pAttArray = NULL;
+    // Cursor initialization
+    pCursor->pBuffer = pBuffer;
+    pCursor->BuffSize = buffSize;
+    pCursor->Repr = repr;
+    pCursor->Depth = 0;
+    pCursor->PendingSubAttNb = 0;
+    pCursor->HasError = false;
+    pCursor->AttLeftArray[0] = header.AttNb;
+    if (pHeader != NULL) {
+        memcpy(pHeader, &header, sizeof(lcsf_raw_msg_t));
+    }
+    return true;
+}
+
+bool LCSF_CursorNext(lcsf_cursor_t *pCursor, lcsf_raw_att_t *pAtt) {
+    // Bad parameters guard
+    if ((pCursor == NULL) || (pAtt == NULL) || pCursor->HasError) {
+        return false;
+    }
+    // Skip the sub-attributes of the previous attribute
+    if (!LCSF_CursorSkip(pCursor, pCursor->PendingSubAttNb)) {
+        return false;
+    }
+    pCursor->PendingSubAttNb = 0;
+    // End of level
+    if (pCursor->AttLeftArray[pCursor->Depth] == 0) {
+        return false;
+    }
+    // Read attribute
+    if (!LCSF_CursorReadAtt(pCursor, pAtt)) {
+        pCursor->HasError = true;
+        return false;
+    }
+    pCursor->AttLeftArray[pCursor->Depth]--;
+    if (pAtt->HasSubAtt) {
+        pCursor->PendingSubAttNb = pAtt->PayloadSize;
+    }
+    return true;
+}
+
+bool LCSF_CursorEnter(lcsf_cursor_t *pCursor) {
+    // Bad parameters guard
+    if ((pCursor == NULL) || pCursor->HasError) {
+        return false;
+    }
+    // Max depth guard
+    if (pCursor->Depth >= LCSF_CURSOR_MAX_DEPTH) {
+        return false;
+    }
+    // Last attribute must have sub-attributes left to read
+    if (pCursor->PendingSubAttNb == 0) {
+        return false;
+    }
+    pCursor->Depth++;
+    pCursor->AttLeftArray[pCursor->Depth] = pCursor->PendingSubAttNb;
+    pCursor->PendingSubAttNb = 0;
+    return true;
+}
+
+bool LCSF_CursorLeave(lcsf_cursor_t *pCursor) {
+    // Bad parameters guard
+    if ((pCursor == NULL) || pCursor->HasError) {
+        return false;
+    }
+    // Top level guard
+    if (pCursor->Depth == 0) {
+        return false;
+    }
+    // Skip the attributes left on this level
+    if (!LCSF_CursorSkip(pCursor, (uint32_t)pCursor->PendingSubAttNb + pCursor->AttLeftArray[pCursor->Depth])) {
+        return false;
+    }
+    pCursor->PendingSubAttNb = 0;
+    pCursor->Depth--;
+    return true;
+}
+
+bool LCSF_CursorDecodeFlat(const uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr, lcsf_raw_msg_t *pHeader,
+    lcsf_flat_node_t *pNodeArray, size_t nodeArraySize, size_t *pNodeNb) {
+    lcsf_cursor_t cursor;
+    lcsf_raw_att_t att;
+    size_t groupIdxArray[LCSF_CURSOR_MAX_DEPTH + 1];
+    size_t nodeNb = 0;
+    // Bad parameters guard
+    if ((pNodeArray == NULL) || (pNodeNb == NULL)) {
+        return false;
+    }
+    if (!LCSF_CursorInit(&cursor, pBuffer, buffSize, repr, pHeader)) {
+        return false;
+    }
+    while (true) {
+        // Close the completed levels, siblings resume after their last node
+        while ((cursor.Depth > 0) && (cursor.AttLeftArray[cursor.Depth] == 0)) {
+            pNodeArray[groupIdxArray[cursor.Depth]].Offset = (uint32_t)nodeNb;
+            cursor.Depth--;
+        }
+        if (cursor.AttLeftArray[cursor.Depth] == 0) {
+            break;
+        }
+        // Node array overflow guard
+        if (nodeNb >= nodeArraySize) {
+            return false;
+        }
+        if (!LCSF_CursorReadAtt(&cursor, &att)) {
+            return false;
+        }
+        cursor.AttLeftArray[cursor.Depth]--;
+        lcsf_flat_node_t *pNode = &(pNodeArray[nodeNb]);
+        pNode->AttId = att.AttId;
+        pNode->HasSubAtt = att.HasSubAtt;
+        pNode->PayloadSize = att.PayloadSize;
+        if (att.HasSubAtt) {
+            // Max depth guard
+            if (cursor.Depth >= LCSF_CURSOR_MAX_DEPTH) {
+                return false;
+            }
+            cursor.Depth++;
+            cursor.AttLeftArray[cursor.Depth] = att.PayloadSize;
+            groupIdxArray[cursor.Depth] = nodeNb;
+        } else {
+            pNode->Offset = (uint32_t)(att.Payload.pData - pBuffer);
+        }
+        nodeNb++;
+    }
+    // Leftover data
+    if (cursor.BuffIdx != buffSize) {
+        return false;
+    }
+    *pNodeNb = nodeNb;
+    return true;
+}
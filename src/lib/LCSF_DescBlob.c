@@ -0,0 +1,189 @@
+/**
+ * \file LCSF_DescBlob.c
+ * \brief Light Command Set Format descriptor blob module, loads relocatable packed descriptors in place
+ * \author Jean-Roland Gosse
+ *
+ * This file is part of LCSF C Stack.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ */
+
+// *** Libraries include ***
+// Standard lib
+#include <string.h>
+// Custom lib
+#include <LCSF_Config.h>
+#include <lib/LCSF_DescBlob.h>
+
+// *** Definitions ***
+// --- Private Types ---
+// --- Private Constants ---
+#define LCSF_BLOB_LAYOUT 0x0001 // Layout version, a byte swapped value means a foreign byte order
+#define LCSF_BLOB_HEADER_SIZE sizeof(lcsf_blob_header_t)
+#define LCSF_BLOB_CMD_SIZE sizeof(lcsf_packed_cmd_desc_t)
+#define LCSF_BLOB_ATT_SIZE sizeof(lcsf_packed_att_desc_t)
+
+static const uint8_t LCSF_BlobMagic[4] = {'L', 'C', 'S', 'F'};
+
+// --- Private Function Prototypes ---
+static size_t LCSF_GetPackedAttNb(const lcsf_packed_prot_desc_t *pPackedDesc);
+static bool LCSF_CheckBlobRecords(const lcsf_blob_header_t *pHeader, const lcsf_packed_cmd_desc_t *pCmdArray,
+    const lcsf_packed_att_desc_t *pAttArray);
+
+// --- Private Variables ---
+// *** End Definitions ***
+
+// *** Private Functions ***
+
+/**
+ * \fn static size_t LCSF_GetPackedAttNb(const lcsf_packed_prot_desc_t *pPackedDesc)
+ * \brief Compute the number of attribute records used by a packed protocol descriptor
+ *
+ * \param pPackedDesc pointer to the packed protocol descriptor
+ * \return size_t: number of attribute records
+ */
+static size_t LCSF_GetPackedAttNb(const lcsf_packed_prot_desc_t *pPackedDesc) {
+    size_t attNb = 0;
+    // Command levels
+    for (uint16_t idx = 0; idx < pPackedDesc->CmdNb; idx++) {
+        const lcsf_packed_cmd_desc_t *pCmd = &(pPackedDesc->pCmdArray[idx]);
+        if ((size_t)(pCmd->AttIdx + pCmd->AttNb) > attNb) {
+            attNb = pCmd->AttIdx + pCmd->AttNb;
+        }
+    }
+    // Sub-attribute levels, found while parsing the records in use
+    for (size_t idx = 0; idx < attNb; idx++) {
+        const lcsf_packed_att_desc_t *pAtt = &(pPackedDesc->pAttArray[idx]);
+        if ((size_t)(pAtt->SubAttIdx + pAtt->SubAttNb) > attNb) {
+            attNb = pAtt->SubAttIdx + pAtt->SubAttNb;
+        }
+    }
+    return attNb;
+}
+
+/**
+ * \fn static bool LCSF_CheckBlobRecords(const lcsf_blob_header_t *pHeader, const lcsf_packed_cmd_desc_t *pCmdArray, const lcsf_packed_att_desc_t *pAttArray)
+ * \brief Check that the reserved field is unused, that every record index stays in the blob and that sub-attribute
+ * levels can't loop
+ *
+ * \param pHeader pointer to the blob header
+ * \param pCmdArray pointer to the command records
+ * \param pAttArray pointer to the attribute records
+ * \return bool: true if the records are valid
+ */
+static bool LCSF_CheckBlobRecords(const lcsf_blob_header_t *pHeader, const lcsf_packed_cmd_desc_t *pCmdArray,
+    const lcsf_packed_att_desc_t *pAttArray) {
+    // Reserved for later layouts, a blob using it is not understood
+    if (pHeader->Reserved != 0) {
+        return false;
+    }
+    for (uint16_t idx = 0; idx < pHeader->CmdNb; idx++) {
+        if ((uint32_t)(pCmdArray[idx].AttIdx + pCmdArray[idx].AttNb) > pHeader->AttNb) {
+            return false;
+        }
+    }
+    for (uint16_t idx = 0; idx < pHeader->AttNb; idx++) {
+        const lcsf_packed_att_desc_t *pAtt = &(pAttArray[idx]);
+        if (pAtt->DataType > LCSF_SUB_ATTRIBUTES) {
+            return false;
+        }
+        if (pAtt->SubAttNb == 0) {
+            continue;
+        }
+        // Sub-attribute levels follow their parent record, which bounds the validator recursion
+        if ((pAtt->DataType != LCSF_SUB_ATTRIBUTES) || (pAtt->SubAttIdx <= idx) ||
+            ((uint32_t)(pAtt->SubAttIdx + pAtt->SubAttNb) > pHeader->AttNb)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// *** Public Functions ***
+
+int LCSF_DescBlobWrite(uint_fast16_t protId, uint_fast16_t protVer, const lcsf_packed_prot_desc_t *pPackedDesc,
+    uint8_t *pBuffer, size_t buffSize) {
+    // Bad parameters guard
+    if ((pPackedDesc == NULL) || (pPackedDesc->pCmdArray == NULL) || (pPackedDesc->pAttArray == NULL) ||
+        (pBuffer == NULL)) {
+        return -1;
+    }
+    size_t attNb = LCSF_GetPackedAttNb(pPackedDesc);
+    size_t blobSize =
+        LCSF_BLOB_HEADER_SIZE + (pPackedDesc->CmdNb * LCSF_BLOB_CMD_SIZE) + (attNb * LCSF_BLOB_ATT_SIZE);
+    // Blob limits and buffer overflow guards
+    if ((attNb > 0xFFFF) || (blobSize > buffSize)) {
+        return -1;
+    }
+    lcsf_blob_header_t header;
+    memcpy(header.Magic, LCSF_BlobMagic, sizeof(header.Magic));
+    header.Layout = LCSF_BLOB_LAYOUT;
+    header.ProtId = (uint16_t)protId;
+    header.ProtVer = (uint16_t)protVer;
+    header.CmdNb = pPackedDesc->CmdNb;
+    header.AttNb = (uint16_t)attNb;
+    header.Reserved = 0;
+    memcpy(pBuffer, &header, LCSF_BLOB_HEADER_SIZE);
+    size_t buffIdx = LCSF_BLOB_HEADER_SIZE;
+    memcpy(&(pBuffer[buffIdx]), pPackedDesc->pCmdArray, pPackedDesc->CmdNb * LCSF_BLOB_CMD_SIZE);
+    buffIdx += pPackedDesc->CmdNb * LCSF_BLOB_CMD_SIZE;
+    memcpy(&(pBuffer[buffIdx]), pPackedDesc->pAttArray, attNb * LCSF_BLOB_ATT_SIZE);
+    return (int)blobSize;
+}
+
+bool LCSF_DescBlobLoad(
+    const uint8_t *pBlob, size_t blobSize, LCSFInterpretCallback_t *pFnInterpretMsg, lcsf_blob_prot_t *pBlobProt) {
+    // Bad parameters guard
+    if ((pBlob == NULL) || (pFnInterpretMsg == NULL) || (pBlobProt == NULL)) {
+        return false;
+    }
+    // Records are used in place, they must be aligned
+    if ((((uintptr_t)pBlob) % sizeof(uint16_t)) != 0) {
+        return false;
+    }
+    // Header guard
+    const lcsf_blob_header_t *pHeader = (const lcsf_blob_header_t *)pBlob;
+    if ((blobSize < LCSF_BLOB_HEADER_SIZE) || (memcmp(pHeader->Magic, LCSF_BlobMagic, sizeof(pHeader->Magic)) != 0) ||
+        (pHeader->Layout != LCSF_BLOB_LAYOUT)) {
+        return false;
+    }
+    size_t recordSize = (pHeader->CmdNb * LCSF_BLOB_CMD_SIZE) + (pHeader->AttNb * LCSF_BLOB_ATT_SIZE);
+    if (blobSize != (LCSF_BLOB_HEADER_SIZE + recordSize)) {
+        return false;
+    }
+    const lcsf_packed_cmd_desc_t *pCmdArray = (const lcsf_packed_cmd_desc_t *)&(pBlob[LCSF_BLOB_HEADER_SIZE]);
+    const lcsf_packed_att_desc_t *pAttArray =
+        (const lcsf_packed_att_desc_t *)&(pBlob[LCSF_BLOB_HEADER_SIZE + pHeader->CmdNb * LCSF_BLOB_CMD_SIZE]);
+    if (!LCSF_CheckBlobRecords(pHeader, pCmdArray, pAttArray)) {
+        return false;
+    }
+    // Fill the protocol entry
+    pBlobProt->PackedDesc.CmdNb = pHeader->CmdNb;
+    pBlobProt->PackedDesc.pCmdArray = pCmdArray;
+    pBlobProt->PackedDesc.pAttArray = pAttArray;
+    memset(&(pBlobProt->Entry), 0, sizeof(lcsf_validator_protocol_desc_t));
+    pBlobProt->Entry.ProtId = pHeader->ProtId;
+    pBlobProt->Entry.ProtVer = pHeader->ProtVer;
+    pBlobProt->Entry.pFnInterpretMsg = pFnInterpretMsg;
+    pBlobProt->Entry.pPackedDesc = &(pBlobProt->PackedDesc);
+    return true;
+}
+
+bool LCSF_DescBlobAddProtocol(uint_fast16_t protIdx, const uint8_t *pBlob, size_t blobSize,
+    LCSFInterpretCallback_t *pFnInterpretMsg, lcsf_blob_prot_t *pBlobProt) {
+    if (!LCSF_DescBlobLoad(pBlob, blobSize, pFnInterpretMsg, pBlobProt)) {
+        return false;
+    }
+    return LCSF_ValidatorAddProtocol(protIdx, &(pBlobProt->Entry));
+}
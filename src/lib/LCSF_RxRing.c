@@ -0,0 +1,186 @@
+/**
+ * \file LCSF_RxRing.c
+ * \brief Light Command Set Format receive ring module, leases received frames while the next ones are filled
+ * \author Jean-Roland Gosse
+ *
+ * This file is part of LCSF C Stack.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ */
+
+// *** Libraries include ***
+// Standard lib
+#include <string.h>
+// Custom lib
+#include <LCSF_Config.h>
+#include <lib/LCSF_RxRing.h>
+
+// *** Definitions ***
+// --- Private Types ---
+
+// Slot state enum, a slot goes from free to ready in the filling context, then back in the processing context.
+// Each hand over is a release store, matched by an acquire load in the other context.
+enum _lcsf_rx_slot_state_enum {
+    LCSF_RX_SLOT_FREE = 0x00,
+    LCSF_RX_SLOT_READY = 0x01,
+    LCSF_RX_SLOT_LEASED = 0x02,
+};
+
+// --- Private Constants ---
+#define LCSF_RX_LEASE_NB 8 // Size of the slot lease bitmap
+#define LCSF_RX_RECEIVE_LEASE_IDX 0 // Lease held by the processing function
+
+// --- Private Function Prototypes ---
+static uint16_t LCSF_NextSlotIdx(const lcsf_rx_ring_t *pRing, uint_fast16_t slotIdx);
+
+// --- Private Variables ---
+// *** End Definitions ***
+
+// *** Private Functions ***
+
+/**
+ * \fn static uint16_t LCSF_NextSlotIdx(const lcsf_rx_ring_t *pRing, uint_fast16_t slotIdx)
+ * \brief Compute the index of the slot following another in the ring
+ *
+ * \param pRing pointer to the ring
+ * \param slotIdx index of the slot
+ * \return uint16_t: index of the next slot
+ */
+static uint16_t LCSF_NextSlotIdx(const lcsf_rx_ring_t *pRing, uint_fast16_t slotIdx) {
+    return (slotIdx + 1 < pRing->SlotNb) ? (uint16_t)(slotIdx + 1) : 0;
+}
+
+// *** Public Functions ***
+
+bool LCSF_RxRingInit(
+    lcsf_rx_ring_t *pRing, uint8_t *pData, size_t slotSize, lcsf_rx_slot_t *pSlotArray, size_t slotNb) {
+    // Bad parameters guard
+    if ((pRing == NULL) || (pData == NULL) || (pSlotArray == NULL) || (slotSize == 0) || (slotNb == 0) ||
+        (slotNb >= UINT16_MAX)) {
+        return false;
+    }
+    for (size_t idx = 0; idx < slotNb; idx++) {
+        lcsf_rx_slot_t *pSlot = &(pSlotArray[idx]);
+        pSlot->FrameSize = 0;
+        pSlot->Generation = 0;
+        pSlot->LeaseMask = 0;
+        LCSF_ATOMIC_STORE(&(pSlot->State), LCSF_RX_SLOT_FREE);
+    }
+    pRing->pData = pData;
+    pRing->pSlotArray = pSlotArray;
+    pRing->SlotSize = slotSize;
+    pRing->SlotNb = (uint16_t)slotNb;
+    pRing->FillIdx = 0;
+    pRing->ProcessIdx = 0;
+    pRing->CurrSlotIdx = pRing->SlotNb;
+    return true;
+}
+
+uint8_t *LCSF_RxRingGetFillBuffer(lcsf_rx_ring_t *pRing) {
+    // Bad parameters guard
+    if (pRing == NULL) {
+        return NULL;
+    }
+    // Ring full guard
+    if (LCSF_ATOMIC_LOAD_ACQUIRE(&(pRing->pSlotArray[pRing->FillIdx].State)) != LCSF_RX_SLOT_FREE) {
+        return NULL;
+    }
+    return &(pRing->pData[pRing->FillIdx * pRing->SlotSize]);
+}
+
+bool LCSF_RxRingCommit(lcsf_rx_ring_t *pRing, size_t frameSize) {
+    // Bad parameters guard
+    if ((pRing == NULL) || (frameSize == 0) || (frameSize > pRing->SlotSize)) {
+        return false;
+    }
+    lcsf_rx_slot_t *pSlot = &(pRing->pSlotArray[pRing->FillIdx]);
+    if (LCSF_ATOMIC_LOAD_ACQUIRE(&(pSlot->State)) != LCSF_RX_SLOT_FREE) {
+        return false;
+    }
+    // The release store publishes the frame size and data with the slot
+    pSlot->FrameSize = frameSize;
+    LCSF_ATOMIC_STORE_RELEASE(&(pSlot->State), LCSF_RX_SLOT_READY);
+    pRing->FillIdx = LCSF_NextSlotIdx(pRing, pRing->FillIdx);
+    return true;
+}
+
+bool LCSF_RxRingProcess(lcsf_rx_ring_t *pRing, lcsf_receive_status_t *pStatus) {
+    // Bad parameters guard
+    if ((pRing == NULL) || (pStatus == NULL) || (pRing->CurrSlotIdx != pRing->SlotNb)) {
+        return false;
+    }
+    uint16_t slotIdx = pRing->ProcessIdx;
+    lcsf_rx_slot_t *pSlot = &(pRing->pSlotArray[slotIdx]);
+    // No frame received guard
+    if (LCSF_ATOMIC_LOAD_ACQUIRE(&(pSlot->State)) != LCSF_RX_SLOT_READY) {
+        return false;
+    }
+    pRing->ProcessIdx = LCSF_NextSlotIdx(pRing, slotIdx);
+    // Lease the frame while it is received, the filling context only waits for the slot to be free
+    pSlot->Generation++;
+    pSlot->LeaseMask = (uint8_t)(1u << LCSF_RX_RECEIVE_LEASE_IDX);
+    LCSF_ATOMIC_STORE(&(pSlot->State), LCSF_RX_SLOT_LEASED);
+    pRing->CurrSlotIdx = slotIdx;
+    *pStatus = LCSF_TranscoderReceive(&(pRing->pData[slotIdx * pRing->SlotSize]), pSlot->FrameSize);
+    pRing->CurrSlotIdx = pRing->SlotNb;
+    // Release the receive lease
+    const lcsf_rx_lease_t lease = {slotIdx, pSlot->Generation, LCSF_RX_RECEIVE_LEASE_IDX};
+    return LCSF_RxRingRelease(pRing, &lease);
+}
+
+bool LCSF_RxRingRetain(lcsf_rx_ring_t *pRing, lcsf_rx_lease_t *pLease) {
+    // Bad parameters guard
+    if ((pRing == NULL) || (pLease == NULL) || (pRing->CurrSlotIdx == pRing->SlotNb)) {
+        return false;
+    }
+    lcsf_rx_slot_t *pSlot = &(pRing->pSlotArray[pRing->CurrSlotIdx]);
+    // Lease bitmap full guard
+    if (pSlot->LeaseMask == UINT8_MAX) {
+        return false;
+    }
+    uint8_t leaseIdx = 0;
+    while ((pSlot->LeaseMask & (1u << leaseIdx)) != 0) {
+        leaseIdx++;
+    }
+    pSlot->LeaseMask |= (uint8_t)(1u << leaseIdx);
+    pLease->SlotIdx = pRing->CurrSlotIdx;
+    pLease->Generation = pSlot->Generation;
+    pLease->LeaseIdx = leaseIdx;
+    return true;
+}
+
+bool LCSF_RxRingRelease(lcsf_rx_ring_t *pRing, const lcsf_rx_lease_t *pLease) {
+    // Bad parameters guard
+    if ((pRing == NULL) || (pLease == NULL) || (pLease->SlotIdx >= pRing->SlotNb) ||
+        (pLease->LeaseIdx >= LCSF_RX_LEASE_NB)) {
+        return false;
+    }
+    lcsf_rx_slot_t *pSlot = &(pRing->pSlotArray[pLease->SlotIdx]);
+    // Stale token guard
+    if ((LCSF_ATOMIC_LOAD_ACQUIRE(&(pSlot->State)) != LCSF_RX_SLOT_LEASED) ||
+        (pSlot->Generation != pLease->Generation)) {
+        return false;
+    }
+    // Double release guard
+    const uint8_t leaseBit = (uint8_t)(1u << pLease->LeaseIdx);
+    if ((pSlot->LeaseMask & leaseBit) == 0) {
+        return false;
+    }
+    pSlot->LeaseMask &= (uint8_t)~leaseBit;
+    if (pSlot->LeaseMask == 0) {
+        // Hand the slot back to the filling context, the release store orders the frame reads before it
+        LCSF_ATOMIC_STORE_RELEASE(&(pSlot->State), LCSF_RX_SLOT_FREE);
+    }
+    return true;
+}
@@ -21,7 +21,6 @@
 
 // *** Libraries include ***
 // Standard lib
-#include <assert.h>
 #include <string.h>
 // Custom lib
 #include <LCSF_Config.h>
@@ -38,8 +37,10 @@ enum _lcsf_decode_error_enum {
     LCSF_DECODE_UNKNOWN_ERROR = 0xFF, // Unknown error
 };
 
+#ifndef LCSF_SHARED_ARENA
 // Decoder lifo data buffer
 static uint8_t DecoderLifoData[LCSF_TRANSCODER_RX_LIFO_SIZE * sizeof(lcsf_raw_att_t)];
+#endif
 
 // Module information structure
 typedef struct _lcsf_trnscdr_info {
@@ -47,28 +48,47 @@ typedef struct _lcsf_trnscdr_info {
     lcsf_raw_msg_t DecoderMsg; // Structure of the decoder message header
     uint8_t *pEncoderBuffer; // Pointer to the transmission buffer
     uint8_t LastErrCode; // Last error code encountered during decoding
+    lcsf_receive_status_t HeaderStatus; // Status of the last decoded message header check or fixed layout receive
+    bool IsProcessed; // Indicates if the last message was received from its fixed layout by the validator
+    const lcsf_route_t *pRouteArray; // Pointer to the optional routing table
+    uint16_t RouteNb; // Number of routes in the table
 } lcsf_trnscdr_info_t;
 
 // --- Private Constants ---
 // --- Private Function Prototypes ---
 // Decode functions
-static bool LCSF_AllocateAttArray(uint_fast16_t attNb, lcsf_raw_att_t **pAttArray);
-static bool LCSF_FetchMsgHeader(uint16_t *pBuffIdx, size_t buffSize, const uint8_t *pBuffer, lcsf_raw_msg_t *pMsg);
-static bool LCSF_FetchAttHeader(uint16_t *pBuffIdx, size_t buffSize, const uint8_t *pBuffer, lcsf_raw_att_t *pAtt);
+static bool LCSF_AllocateAttArray(size_t attNb, lcsf_raw_att_t **pAttArray);
+static bool LCSF_FetchMsgHeader(
+    uint16_t *pBuffIdx, size_t buffSize, const uint8_t *pBuffer, lcsf_raw_msg_t *pMsg, lcsf_repr_t repr);
+static void LCSF_ReadAttHeader(uint16_t *pBuffIdx, const uint8_t *pBuffer, lcsf_raw_att_t *pAtt, lcsf_repr_t repr);
+static bool LCSF_FetchAttHeader(
+    uint16_t *pBuffIdx, size_t buffSize, const uint8_t *pBuffer, lcsf_raw_att_t *pAtt, lcsf_repr_t repr);
 static bool LCSF_FetchAttData(
     uint16_t *pBuffIdx, size_t buffSize, const uint8_t *pBuffer, size_t attDataSize, uint8_t **pAttData);
-static bool LCSF_DecodeAtt_Rec(
-    uint16_t *pBuffIdx, const uint8_t *pBuffer, size_t buffSize, uint_fast16_t attNb, lcsf_raw_att_t *pAttArray);
-static bool LCSF_DecodeBuffer(const uint8_t *pBuffer, size_t buffSize, lcsf_raw_msg_t *pMsg);
+static bool LCSF_ScanAtt(uint16_t buffIdx, const uint8_t *pBuffer, size_t buffSize, uint_fast16_t attNb,
+    lcsf_repr_t repr, size_t *pTotalAttNb);
+static void LCSF_DecodeAtt_Rec(uint16_t *pBuffIdx, const uint8_t *pBuffer, lcsf_repr_t repr, uint_fast16_t attNb,
+    lcsf_raw_att_t *pAttArray, lcsf_raw_att_t **pFreeAttArray);
+static bool LCSF_DecodeBuffer(const uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr, lcsf_raw_msg_t *pMsg);
+static const lcsf_route_t *LCSF_FindRoute(const uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr);
 // Encode functions
-static bool LCSF_FillMsgHeader(uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buffSize, const lcsf_raw_msg_t *pMsg);
-static bool LCSF_FillAttHeader(uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buffSize, const lcsf_raw_att_t *pAtt);
+static bool LCSF_FillMsgHeader(
+    uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buffSize, const lcsf_raw_msg_t *pMsg, lcsf_repr_t repr);
+static bool LCSF_FillAttHeader(
+    uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buffSize, const lcsf_raw_att_t *pAtt, lcsf_repr_t repr);
 static bool LCSF_FillAttData(uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buffSize, const lcsf_raw_att_t *pAtt);
-static bool LCSF_EncodeAtt_Rec(
-    uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buffSize, uint_fast16_t attNb, const lcsf_raw_att_t *pAttArray);
-static bool LCSF_EncodeBuffer(uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buffSize, const lcsf_raw_msg_t *pMsg);
+static bool LCSF_EncodeAtt_Rec(uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr, uint_fast16_t attNb,
+    const lcsf_raw_att_t *pAttArray);
+static bool LCSF_EncodeBuffer(
+    uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr, const lcsf_raw_msg_t *pMsg);
+// Convert functions
+static bool LCSF_ConvertBuffer(uint16_t *pInIdx, const uint8_t *pInBuffer, size_t inSize, lcsf_repr_t inRepr,
+    uint16_t *pOutIdx, uint8_t *pOutBuffer, size_t outSize, lcsf_repr_t outRepr);
 // External functions
-extern bool LCSF_ValidatorSendTranscoderError(uint_fast8_t errorType);
+extern bool LCSF_ValidatorSendTranscoderError(uint_fast8_t errorType, lcsf_repr_t repr);
+extern lcsf_receive_status_t LCSF_ValidatorCheckHeader(const lcsf_raw_msg_t *pMessage, lcsf_repr_t repr);
+extern bool LCSF_ValidatorReceiveFixed(const lcsf_raw_msg_t *pMessage, const uint8_t *pBuffer, size_t buffSize,
+    lcsf_repr_t repr, lcsf_receive_status_t *pStatus);
 
 // --- Private Variables ---
 static lcsf_trnscdr_info_t LcsfTranscoderInfo;
@@ -78,43 +98,46 @@ static lcsf_trnscdr_info_t LcsfTranscoderInfo;
 // *** Private Functions ***
 
 /**
- * \fn static bool LCSF_AllocateAttArray(uint_fast16_t attNb, lcsf_raw_att_t **pAttArray)
+ * \fn static bool LCSF_AllocateAttArray(size_t attNb, lcsf_raw_att_t **pAttArray)
  * \brief Allocate an lcsf attribute array
  *
  * \param attNb number of attributes in the array
  * \param pAttArray pointer to contain the array address
  * \return bool: true if operation was a success
  */
-static bool LCSF_AllocateAttArray(uint_fast16_t attNb, lcsf_raw_att_t **pAttArray) {
+static bool LCSF_AllocateAttArray(size_t attNb, lcsf_raw_att_t **pAttArray) {
     // Attempt to allocate the array from the lifo
     return LifoGet(&LcsfTranscoderInfo.DecoderLifo, attNb, (void **)pAttArray);
 }
 
 /**
- * \fn static bool LCSF_FetchMsgHeader(uint16_t *pBuffIdx, size_t buffSize, const uint8_t *pBuffer, lcsf_raw_msg_t *pMsg)
+ * \fn static bool LCSF_FetchMsgHeader(uint16_t *pBuffIdx, size_t buffSize, const uint8_t *pBuffer, lcsf_raw_msg_t *pMsg, lcsf_repr_t repr)
  * \brief Fill an lcsf_msg_header struct from a buffer
  *
  * \param pBuffIdx pointer to the buffer index
  * \param buffSize size of the buffer
  * \param pBuffer pointer to the buffer
  * \param pMsg pointer to the lcsf_msg_header
+ * \param repr message representation
  * \return bool: true if operation was a success
  */
-static bool LCSF_FetchMsgHeader(uint16_t *pBuffIdx, size_t buffSize, const uint8_t *pBuffer, lcsf_raw_msg_t *pMsg) {
-#ifdef LCSF_SMALL
-    // Buffer overflow guard
-    if ((size_t)(*pBuffIdx + 3) >= buffSize) {
-        return false;
+static bool LCSF_FetchMsgHeader(
+    uint16_t *pBuffIdx, size_t buffSize, const uint8_t *pBuffer, lcsf_raw_msg_t *pMsg, lcsf_repr_t repr) {
+    if (repr == LCSF_REPR_SMALL) {
+        // Buffer overflow guard
+        if ((size_t)(*pBuffIdx + 3) >= buffSize) {
+            return false;
+        }
+        // Byte 1: Protocol id
+        pMsg->ProtId = pBuffer[(*pBuffIdx)++];
+        // Byte 2: Protocol version
+        pMsg->ProtVer = pBuffer[(*pBuffIdx)++];
+        // Byte 3: Command id
+        pMsg->CmdId = pBuffer[(*pBuffIdx)++];
+        // Byte 4: Attribute number
+        pMsg->AttNb = pBuffer[(*pBuffIdx)++];
+        return true;
     }
-    // Byte 1: Protocol id
-    pMsg->ProtId = pBuffer[(*pBuffIdx)++];
-    // Byte 2: Protocol version
-    pMsg->ProtVer = pBuffer[(*pBuffIdx)++];
-    // Byte 3: Command id
-    pMsg->CmdId = pBuffer[(*pBuffIdx)++];
-    // Byte 4: Attribute number
-    pMsg->AttNb = pBuffer[(*pBuffIdx)++];
-#else
     // Buffer overflow guard
     if ((size_t)(*pBuffIdx + 7) >= buffSize) {
         return false;
@@ -135,38 +158,30 @@ static bool LCSF_FetchMsgHeader(uint16_t *pBuffIdx, size_t buffSize, const uint8
     pMsg->AttNb = pBuffer[(*pBuffIdx)++];
     // Byte 8: Attribute Number MSB
     pMsg->AttNb += pBuffer[(*pBuffIdx)++] << 8;
-#endif
     return true;
 }
 
 /**
- * \fn static bool LCSF_FetchAttHeader(uint16_t *pBuffIdx, size_t buffSize, const uint8_t *pBuffer, lcsf_raw_att_t *pAtt)
- * \brief Fill an lcsf_att_header struct from a buffer
+ * \fn static void LCSF_ReadAttHeader(uint16_t *pBuffIdx, const uint8_t *pBuffer, lcsf_raw_att_t *pAtt, lcsf_repr_t repr)
+ * \brief Fill an lcsf_att_header struct from a buffer, without bounds checks
  *
  * \param pBuffIdx pointer to the buffer index
- * \param buffSize size of the buffer
  * \param pBuffer pointer to the buffer
  * \param pAtt pointer to the lcsf_msg_header
- * \return bool: true if operation was a success
+ * \param repr message representation
+ * \return void
  */
-static bool LCSF_FetchAttHeader(uint16_t *pBuffIdx, size_t buffSize, const uint8_t *pBuffer, lcsf_raw_att_t *pAtt) {
-#ifdef LCSF_SMALL
-    // Buffer overflow guard
-    if ((size_t)(*pBuffIdx + 1) >= buffSize) {
-        return false;
-    }
-    // Byte 1 (MSbit): Complexity flag (the attribute have sub-attributes if set)
-    pAtt->HasSubAtt = ((pBuffer[*pBuffIdx] & (1 << 7)) != 0);
-    // Byte 1: Attribute id
-    pAtt->AttId = pBuffer[(*pBuffIdx)++];
-    // Mask the complexity flag from attribute id
-    pAtt->AttId &= ~(1 << 7);
-    // Byte 2: Payload size
-    pAtt->PayloadSize = pBuffer[(*pBuffIdx)++];
-#else
-    // Buffer overflow guard
-    if ((size_t)(*pBuffIdx + 3) >= buffSize) {
-        return false;
+static void LCSF_ReadAttHeader(uint16_t *pBuffIdx, const uint8_t *pBuffer, lcsf_raw_att_t *pAtt, lcsf_repr_t repr) {
+    if (repr == LCSF_REPR_SMALL) {
+        // Byte 1 (MSbit): Complexity flag (the attribute have sub-attributes if set)
+        pAtt->HasSubAtt = ((pBuffer[*pBuffIdx] & (1 << 7)) != 0);
+        // Byte 1: Attribute id
+        pAtt->AttId = pBuffer[(*pBuffIdx)++];
+        // Mask the complexity flag from attribute id
+        pAtt->AttId &= ~(1 << 7);
+        // Byte 2: Payload size
+        pAtt->PayloadSize = pBuffer[(*pBuffIdx)++];
+        return;
     }
     // Byte 1: Attribute id LSB
     pAtt->AttId = pBuffer[(*pBuffIdx)++];
@@ -178,7 +193,27 @@ static bool LCSF_FetchAttHeader(uint16_t *pBuffIdx, size_t buffSize, const uint8
     pAtt->PayloadSize = pBuffer[(*pBuffIdx)++];
     // Byte 4: Data size or Sub-attribute number MSB
     pAtt->PayloadSize += pBuffer[(*pBuffIdx)++] << 8;
-#endif
+}
+
+/**
+ * \fn static bool LCSF_FetchAttHeader(uint16_t *pBuffIdx, size_t buffSize, const uint8_t *pBuffer, lcsf_raw_att_t *pAtt, lcsf_repr_t repr)
+ * \brief Fill an lcsf_att_header struct from a buffer
+ *
+ * \param pBuffIdx pointer to the buffer index
+ * \param buffSize size of the buffer
+ * \param pBuffer pointer to the buffer
+ * \param pAtt pointer to the lcsf_msg_header
+ * \param repr message representation
+ * \return bool: true if operation was a success
+ */
+static bool LCSF_FetchAttHeader(
+    uint16_t *pBuffIdx, size_t buffSize, const uint8_t *pBuffer, lcsf_raw_att_t *pAtt, lcsf_repr_t repr) {
+    size_t attHeaderSize = (repr == LCSF_REPR_SMALL) ? 2 : 4;
+    // Buffer overflow guard
+    if ((size_t)(*pBuffIdx + attHeaderSize) > buffSize) {
+        return false;
+    }
+    LCSF_ReadAttHeader(pBuffIdx, pBuffer, pAtt, repr);
     return true;
 }
 
@@ -207,124 +242,209 @@ static bool LCSF_FetchAttData(
 }
 
 /**
- * \fn static bool LCSF_AttDecode_Rec(uint16_t *pBuffIdx, const uint8_t *pBuffer, size_t buffSize, uint_fast16_t attNb, lcsf_raw_att_t *pAttArray)
- * \brief Decode recursively the lcsf attributes from a buffer
+ * \fn static bool LCSF_ScanAtt(uint16_t buffIdx, const uint8_t *pBuffer, size_t buffSize, uint_fast16_t attNb, lcsf_repr_t repr, size_t *pTotalAttNb)
+ * \brief Check that the lcsf attributes of a buffer fit it exactly and count them (sub-attributes included)
  *
- * \param pBuffIdx pointer to the buffer index
+ * Payload sizes are known from the headers, so attributes are scanned in order with a running count of the
+ * attributes left, without recursion. If the scan fails, the count includes the attributes announced but not scanned.
+ *
+ * \param buffIdx index of the first attribute in the buffer
  * \param pBuffer pointer to the buffer
  * \param buffSize size of the buffer
+ * \param attNb number of top level attributes
+ * \param repr message representation
+ * \param pTotalAttNb pointer to contain the total number of attributes
+ * \return bool: true if operation was a success
+ */
+static bool LCSF_ScanAtt(uint16_t buffIdx, const uint8_t *pBuffer, size_t buffSize, uint_fast16_t attNb,
+    lcsf_repr_t repr, size_t *pTotalAttNb) {
+    uint32_t attLeftNb = attNb;
+    size_t totalAttNb = 0;
+    lcsf_raw_att_t att;
+    uint8_t *pAttData;
+    bool isValid = true;
+
+    while (isValid && (attLeftNb > 0)) {
+        attLeftNb--;
+        totalAttNb++;
+        // Check attribute header extent
+        if (!LCSF_FetchAttHeader(&buffIdx, buffSize, pBuffer, &att, repr)) {
+            isValid = false;
+        } else if (att.HasSubAtt) {
+            // Sub-attributes follow
+            attLeftNb += att.PayloadSize;
+        } else if (!LCSF_FetchAttData(&buffIdx, buffSize, pBuffer, att.PayloadSize, &pAttData)) {
+            // Attribute data extent
+            isValid = false;
+        }
+    }
+    *pTotalAttNb = totalAttNb + attLeftNb;
+    // Leftover data
+    return isValid && (buffIdx == buffSize);
+}
+
+/**
+ * \fn static void LCSF_DecodeAtt_Rec(uint16_t *pBuffIdx, const uint8_t *pBuffer, lcsf_repr_t repr, uint_fast16_t attNb, lcsf_raw_att_t *pAttArray, lcsf_raw_att_t **pFreeAttArray)
+ * \brief Decode recursively the lcsf attributes from a scanned buffer, without bounds checks
+ *
+ * \param pBuffIdx pointer to the buffer index
+ * \param pBuffer pointer to the buffer
+ * \param repr message representation
  * \param attNb number of attributes in the array
  * \param pAttArray pointer to the attributes array
- * \return bool: true if operation was a success
+ * \param pFreeAttArray pointer to the first free attribute of the reserved attributes
+ * \return void
  */
-static bool LCSF_DecodeAtt_Rec(
-    uint16_t *pBuffIdx, const uint8_t *pBuffer, size_t buffSize, uint_fast16_t attNb, lcsf_raw_att_t *pAttArray) {
+static void LCSF_DecodeAtt_Rec(uint16_t *pBuffIdx, const uint8_t *pBuffer, lcsf_repr_t repr, uint_fast16_t attNb,
+    lcsf_raw_att_t *pAttArray, lcsf_raw_att_t **pFreeAttArray) {
     // Parse through the attribute array
     for (uint16_t attIdx = 0; attIdx < attNb; attIdx++) {
-        // Guard against buffer overflow
-        if ((size_t)(*pBuffIdx) < buffSize) {
-            // Decode current attribute header
-            if (!LCSF_FetchAttHeader(pBuffIdx, buffSize, pBuffer, &(pAttArray[attIdx]))) {
-                LcsfTranscoderInfo.LastErrCode = LCSF_DECODE_FORMAT_ERROR;
-                return false;
-            }
-            // Test if attribute has data or sub-attributes
-            if (pAttArray[attIdx].HasSubAtt) {
-                // Allocate the sub-attribute array
-                if (!LCSF_AllocateAttArray(pAttArray[attIdx].PayloadSize, &(pAttArray[attIdx].Payload.pSubAttArray))) {
-                    LcsfTranscoderInfo.LastErrCode = LCSF_DECODE_OVERFLOW_ERROR;
-                    return false;
-                }
-                // Decode current attribute sub-attribute array
-                if (!LCSF_DecodeAtt_Rec(pBuffIdx, pBuffer, buffSize, pAttArray[attIdx].PayloadSize,
-                        pAttArray[attIdx].Payload.pSubAttArray)) {
-                    return false;
-                }
-            } else {
-                // Decode attribute data
-                if (!LCSF_FetchAttData(
-                        pBuffIdx, buffSize, pBuffer, pAttArray[attIdx].PayloadSize, &(pAttArray[attIdx].Payload.pData))) {
-                    LcsfTranscoderInfo.LastErrCode = LCSF_DECODE_FORMAT_ERROR;
-                    return false;
-                }
-            }
+        lcsf_raw_att_t *pAtt = &(pAttArray[attIdx]);
+        // Decode current attribute header
+        LCSF_ReadAttHeader(pBuffIdx, pBuffer, pAtt, repr);
+        // Test if attribute has data or sub-attributes
+        if (pAtt->HasSubAtt) {
+            // Take the sub-attribute array from the reserved attributes
+            pAtt->Payload.pSubAttArray = *pFreeAttArray;
+            *pFreeAttArray += pAtt->PayloadSize;
+            // Decode current attribute sub-attribute array
+            LCSF_DecodeAtt_Rec(pBuffIdx, pBuffer, repr, pAtt->PayloadSize, pAtt->Payload.pSubAttArray, pFreeAttArray);
         } else {
-            LcsfTranscoderInfo.LastErrCode = LCSF_DECODE_FORMAT_ERROR;
-            return false;
+            // Recopy the pointer, the buffer must not to be re-written before being processed!
+            pAtt->Payload.pData = (uint8_t *)&(pBuffer[*pBuffIdx]);
+            *pBuffIdx += pAtt->PayloadSize;
         }
     }
-    return true;
 }
 
 /**
- * \fn static bool LCSF_DecodeBuffer(const uint8_t *pBuffer, size_t buffSize, lcsf_raw_msg_t *pMsg)
+ * \fn static bool LCSF_DecodeBuffer(const uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr, lcsf_raw_msg_t *pMsg)
  * \brief Decode a buffer into an lcsf_msg_header
  *
  * \param pBuffer pointer to the buffer
  * \param buffSize size of the buffer
+ * \param repr message representation
  * \param pMsg pointer to contain the message header
- * \param pLifo pointer to the decoder lifo
  * \return bool: true if operation was a success
  */
-static bool LCSF_DecodeBuffer(const uint8_t *pBuffer, size_t buffSize, lcsf_raw_msg_t *pMsg) {
+static bool LCSF_DecodeBuffer(const uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr, lcsf_raw_msg_t *pMsg) {
     uint16_t buffIdx = 0;
 
     // Clear lifo memory
     LifoFreeAll(&LcsfTranscoderInfo.DecoderLifo);
     // Message header initialization
     memset(pMsg, 0, sizeof(lcsf_raw_msg_t));
+    LcsfTranscoderInfo.HeaderStatus = LCSF_RECEIVE_OK;
+    LcsfTranscoderInfo.IsProcessed = false;
     // Decode message header
-    if (!LCSF_FetchMsgHeader(&buffIdx, buffSize, pBuffer, pMsg)) {
+    if (!LCSF_FetchMsgHeader(&buffIdx, buffSize, pBuffer, pMsg, repr)) {
         LcsfTranscoderInfo.LastErrCode = LCSF_DECODE_FORMAT_ERROR;
         return false;
     }
+    // Reject unknown messages before decoding their attributes
+    LcsfTranscoderInfo.HeaderStatus = LCSF_ValidatorCheckHeader(pMsg, repr);
+    if (LcsfTranscoderInfo.HeaderStatus != LCSF_RECEIVE_OK) {
+        return false;
+    }
+    // Fixed layout commands are received straight from the buffer
+    if (LCSF_ValidatorReceiveFixed(
+            pMsg, &pBuffer[buffIdx], buffSize - buffIdx, repr, &LcsfTranscoderInfo.HeaderStatus)) {
+        LcsfTranscoderInfo.IsProcessed = true;
+        return true;
+    }
     // Test if there is attributes to decode
-    if (pMsg->AttNb > 0) {
-        // Allocate the attribute array
-        if (!LCSF_AllocateAttArray(pMsg->AttNb, &(pMsg->pAttArray))) {
-            LcsfTranscoderInfo.LastErrCode = LCSF_DECODE_OVERFLOW_ERROR;
-            return false;
-        }
-        // Decode attribute array
-        if (!LCSF_DecodeAtt_Rec(&buffIdx, pBuffer, buffSize, pMsg->AttNb, pMsg->pAttArray)) {
+    if (pMsg->AttNb == 0) {
+        // Leftover data
+        if (buffIdx != buffSize) {
+            LcsfTranscoderInfo.LastErrCode = LCSF_DECODE_FORMAT_ERROR;
             return false;
         }
+        return true;
     }
-    // There was no error but there is leftover data, this shouldn't happen
-    if (buffIdx != buffSize) {
+    // Check the attribute extents and count them
+    size_t totalAttNb = 0;
+    bool isScanned = LCSF_ScanAtt(buffIdx, pBuffer, buffSize, pMsg->AttNb, repr, &totalAttNb);
+    // Allocate all the attributes at once, messages announcing more attributes than the lifo can hold overflow
+    if (!LCSF_AllocateAttArray(totalAttNb, &(pMsg->pAttArray))) {
+        LcsfTranscoderInfo.LastErrCode = LCSF_DECODE_OVERFLOW_ERROR;
+        return false;
+    }
+    if (!isScanned) {
+        // Free lifo
+        LifoFreeAll(&LcsfTranscoderInfo.DecoderLifo);
         LcsfTranscoderInfo.LastErrCode = LCSF_DECODE_FORMAT_ERROR;
         return false;
     }
+    // Decode attribute array, extents were already checked
+    lcsf_raw_att_t *pFreeAttArray = pMsg->pAttArray + pMsg->AttNb;
+    LCSF_DecodeAtt_Rec(&buffIdx, pBuffer, repr, pMsg->AttNb, pMsg->pAttArray, &pFreeAttArray);
     return true;
 }
 
 /**
- * \fn static bool LCSF_FillMsgHeader(uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buffSize, const lcsf_raw_msg_t *pMsg)
+ * \fn static const lcsf_route_t *LCSF_FindRoute(const uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr)
+ * \brief Find the route matching a message header, only the header is read
+ *
+ * \param pBuffer pointer to the buffer
+ * \param buffSize size of the buffer
+ * \param repr message representation
+ * \return lcsf_route_t *: pointer to the route, NULL if none matches
+ */
+static const lcsf_route_t *LCSF_FindRoute(const uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr) {
+    uint16_t buffIdx = 0;
+    lcsf_raw_msg_t header;
+
+    // No routing table guard
+    if (LcsfTranscoderInfo.pRouteArray == NULL) {
+        return NULL;
+    }
+    // Peek message header
+    if (!LCSF_FetchMsgHeader(&buffIdx, buffSize, pBuffer, &header, repr)) {
+        return NULL;
+    }
+    // Parse routing table
+    for (uint16_t idx = 0; idx < LcsfTranscoderInfo.RouteNb; idx++) {
+        const lcsf_route_t *pRoute = &LcsfTranscoderInfo.pRouteArray[idx];
+
+        if ((pRoute->ProtId == header.ProtId) && (pRoute->IsAnyCmd || (pRoute->CmdId == header.CmdId))) {
+            return pRoute;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \fn static bool LCSF_FillMsgHeader(uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buffSize, const lcsf_raw_msg_t *pMsg, lcsf_repr_t repr)
  * \brief Encode an lcsf_msg_header into a buffer
  *
  * \param pBuffIdx pointer to the buffer index
  * \param pBuffer pointer to the buffer
  * \param buffSize buffer size
  * \param pMsg pointer to the message header
+ * \param repr message representation
  * \return bool: true if operation was a success
  */
-static bool LCSF_FillMsgHeader(uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buffSize, const lcsf_raw_msg_t *pMsg) {
-#ifdef LCSF_SMALL
-    // Buffer overflow guard
-    if ((size_t)(*pBuffIdx + 3) >= buffSize) {
-        return false;
+static bool LCSF_FillMsgHeader(
+    uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buffSize, const lcsf_raw_msg_t *pMsg, lcsf_repr_t repr) {
+    if (repr == LCSF_REPR_SMALL) {
+        // Buffer overflow guard
+        if ((size_t)(*pBuffIdx + 3) >= buffSize) {
+            return false;
+        }
+        // Smaller representation contract: header fields are 8-bit
+        if ((pMsg->ProtId > 0xFF) || (pMsg->ProtVer > 0xFF) || (pMsg->CmdId > 0xFF) || (pMsg->AttNb > 0xFF)) {
+            return false;
+        }
+        // Byte 1: Protocol id
+        pBuffer[(*pBuffIdx)++] = (uint8_t)pMsg->ProtId;
+        // Byte 2: Protocol version
+        pBuffer[(*pBuffIdx)++] = (uint8_t)pMsg->ProtVer;
+        // Byte 3: Command id
+        pBuffer[(*pBuffIdx)++] = (uint8_t)pMsg->CmdId;
+        // Byte 4: Attribute number
+        pBuffer[(*pBuffIdx)++] = (uint8_t)pMsg->AttNb;
+        return true;
     }
-    // Smaller representation contract: header fields are 8-bit
-    assert((pMsg->ProtId <= 0xFF) && (pMsg->ProtVer <= 0xFF) && (pMsg->CmdId <= 0xFF) && (pMsg->AttNb <= 0xFF));
-    // Byte 1: Protocol id
-    pBuffer[(*pBuffIdx)++] = (uint8_t)pMsg->ProtId;
-    // Byte 2: Protocol version
-    pBuffer[(*pBuffIdx)++] = (uint8_t)pMsg->ProtVer;
-    // Byte 3: Command id
-    pBuffer[(*pBuffIdx)++] = (uint8_t)pMsg->CmdId;
-    // Byte 4: Attribute number
-    pBuffer[(*pBuffIdx)++] = (uint8_t)pMsg->AttNb;
-#else
     // Buffer overflow guard
     if ((size_t)(*pBuffIdx + 7) >= buffSize) {
         return false;
@@ -345,39 +465,44 @@ static bool LCSF_FillMsgHeader(uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buff
     pBuffer[(*pBuffIdx)++] = (uint8_t)pMsg->AttNb;
     // Byte 8: Attribute number MSB
     pBuffer[(*pBuffIdx)++] = (uint8_t)(pMsg->AttNb >> 8);
-#endif
     return true;
 }
 
 /**
- * \fn static bool LCSF_FillAttHeader(uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buffSize, const lcsf_raw_att_t *pAtt)
+ * \fn static bool LCSF_FillAttHeader(uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buffSize, const lcsf_raw_att_t *pAtt, lcsf_repr_t repr)
  * \brief Encode an lcsf_att_header into a buffer
  *
  * \param pBuffIdx pointer to the buffer index
  * \param pBuffer pointer to the buffer
  * \param buffSize buffer size
  * \param pAtt pointer to the attribute
+ * \param repr message representation
  * \return bool: true if operation was a success
  */
-static bool LCSF_FillAttHeader(uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buffSize, const lcsf_raw_att_t *pAtt) {
-#ifdef LCSF_SMALL
-    // Buffer overflow guard
-    if ((size_t)(*pBuffIdx + 1) >= buffSize) {
-        return false;
-    }
-    // Smaller representation contract: 7-bit attribute id (MSb is the complexity flag), 8-bit payload size
-    assert((pAtt->AttId <= 0x7F) && (pAtt->PayloadSize <= 0xFF));
-    // Check if attribute has sub attributes
-    if (pAtt->HasSubAtt) {
-        // Byte 1: Attribute id + MSb at 1
-        pBuffer[(*pBuffIdx)++] = (uint8_t)((pAtt->AttId) | 0x80);
-    } else {
-        // Byte 1: Attribute id + MSb at 0
-        pBuffer[(*pBuffIdx)++] = (uint8_t)((pAtt->AttId) & 0x7F);
+static bool LCSF_FillAttHeader(
+    uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buffSize, const lcsf_raw_att_t *pAtt, lcsf_repr_t repr) {
+    if (repr == LCSF_REPR_SMALL) {
+        // Buffer overflow guard
+        if ((size_t)(*pBuffIdx + 1) >= buffSize) {
+            return false;
+        }
+        // Smaller representation contract: 7-bit attribute id (MSb is the complexity flag), 8-bit payload size
+        if ((pAtt->AttId > 0x7F) || (pAtt->PayloadSize > 0xFF)) {
+            return false;
+        }
+        // Check if attribute has sub attributes
+        if (pAtt->HasSubAtt) {
+            // Byte 1: Attribute id + MSb at 1
+            pBuffer[(*pBuffIdx)++] = (uint8_t)((pAtt->AttId) | 0x80);
+        } else {
+            // Byte 1: Attribute id + MSb at 0
+            pBuffer[(*pBuffIdx)++] = (uint8_t)((pAtt->AttId) & 0x7F);
+        }
+        // Byte 2: Attribute data size or sub-attribute number
+        pBuffer[(*pBuffIdx)++] = (uint8_t)pAtt->PayloadSize;
+        return true;
     }
-    // Byte 2: Attribute data size or sub-attribute number
-    pBuffer[(*pBuffIdx)++] = (uint8_t)pAtt->PayloadSize;
-#else
+    // Buffer overflow guard
     if ((size_t)(*pBuffIdx + 3) >= buffSize) {
         return false;
     }
@@ -395,7 +520,6 @@ static bool LCSF_FillAttHeader(uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buff
     pBuffer[(*pBuffIdx)++] = (uint8_t)pAtt->PayloadSize;
     // Byte 4: Attribute data size or sub-attribute number MSB
     pBuffer[(*pBuffIdx)++] = (uint8_t)(pAtt->PayloadSize >> 8);
-#endif
     return true;
 }
 
@@ -422,18 +546,19 @@ static bool LCSF_FillAttData(uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buffSi
 }
 
 /**
- * \fn static int32_t LCSF_AttEncode_Rec(uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buffSize, uint_fast16_t attNb, const lcsf_raw_att_t *pAttArray)
+ * \fn static int32_t LCSF_AttEncode_Rec(uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr, uint_fast16_t attNb, const lcsf_raw_att_t *pAttArray)
  * \brief Recursively encode an lcsf_att_header array into a buffer
  *
  * \param pBuffIdx pointer to the buffer index
  * \param pBuffer pointer to the buffer
  * \param buffSize buffer size
+ * \param repr message representation
  * \param attNb number of attributes in the array
  * \param pAttArray pointer to the attribute header array
  * \return int32_t: Number of data bytes (sub-attributes included) of an attribute (-1 if error)
  */
-static bool LCSF_EncodeAtt_Rec(
-    uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buffSize, uint_fast16_t attNb, const lcsf_raw_att_t *pAttArray) {
+static bool LCSF_EncodeAtt_Rec(uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr, uint_fast16_t attNb,
+    const lcsf_raw_att_t *pAttArray) {
     // Parse the attribute array
     for (uint16_t attIdx = 0; attIdx < attNb; attIdx++) {
         // Guard against buffer overflow
@@ -441,14 +566,14 @@ static bool LCSF_EncodeAtt_Rec(
             return false;
         }
         // Fill attribute header
-        if (!LCSF_FillAttHeader(pBuffIdx, pBuffer, buffSize, &(pAttArray[attIdx]))) {
+        if (!LCSF_FillAttHeader(pBuffIdx, pBuffer, buffSize, &(pAttArray[attIdx]), repr)) {
             return false;
         }
         // Test if attribute has sub-attributes
         if (pAttArray[attIdx].HasSubAtt) {
             // Encode current attribute sub-attribute array
-            if (!LCSF_EncodeAtt_Rec(
-                    pBuffIdx, pBuffer, buffSize, pAttArray[attIdx].PayloadSize, pAttArray[attIdx].Payload.pSubAttArray)) {
+            if (!LCSF_EncodeAtt_Rec(pBuffIdx, pBuffer, buffSize, repr, pAttArray[attIdx].PayloadSize,
+                    pAttArray[attIdx].Payload.pSubAttArray)) {
                 return false;
             }
         } else {
@@ -462,51 +587,162 @@ static bool LCSF_EncodeAtt_Rec(
 }
 
 /**
- * \fn static bool LCSF_BufferEncode(uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buffSize, const lcsf_raw_msg_t *pMsg)
+ * \fn static bool LCSF_BufferEncode(uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr, const lcsf_raw_msg_t *pMsg)
  * \brief Encode lcsf_msg_header into a buffer
  *
  * \param pBuffIdx pointer to the buffer index
  * \param pBuffer pointer to the buffer
  * \param buffSize buffer size
+ * \param repr message representation
  * \param pMsg pointer to the message header
  * \return bool: true if operation was a success
  */
-static bool LCSF_EncodeBuffer(uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buffSize, const lcsf_raw_msg_t *pMsg) {
+static bool LCSF_EncodeBuffer(
+    uint16_t *pBuffIdx, uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr, const lcsf_raw_msg_t *pMsg) {
     // Encode the message header
-    if (!LCSF_FillMsgHeader(pBuffIdx, pBuffer, buffSize, pMsg)) {
+    if (!LCSF_FillMsgHeader(pBuffIdx, pBuffer, buffSize, pMsg, repr)) {
         return false;
     }
     // Encode the attribute array
-    if (!LCSF_EncodeAtt_Rec(pBuffIdx, pBuffer, buffSize, pMsg->AttNb, pMsg->pAttArray)) {
+    if (!LCSF_EncodeAtt_Rec(pBuffIdx, pBuffer, buffSize, repr, pMsg->AttNb, pMsg->pAttArray)) {
         return false;
     }
     return true;
 }
 
+/**
+ * \fn static bool LCSF_ConvertBuffer(uint16_t *pInIdx, const uint8_t *pInBuffer, size_t inSize, lcsf_repr_t inRepr,
+ * uint16_t *pOutIdx, uint8_t *pOutBuffer, size_t outSize, lcsf_repr_t outRepr)
+ * \brief Rewrite the headers of an encoded message into another representation and copy the payloads
+ *
+ * Sizes of data payloads and sub-attribute numbers don't depend on the representation, so attributes are converted
+ * in order with a running count of the attributes left, no attribute tree nor recursion is needed.
+ *
+ * \param pInIdx pointer to the input buffer index
+ * \param pInBuffer pointer to the input buffer
+ * \param inSize input buffer size
+ * \param inRepr input representation
+ * \param pOutIdx pointer to the output buffer index
+ * \param pOutBuffer pointer to the output buffer
+ * \param outSize output buffer size
+ * \param outRepr output representation
+ * \return bool: true if operation was a success
+ */
+static bool LCSF_ConvertBuffer(uint16_t *pInIdx, const uint8_t *pInBuffer, size_t inSize, lcsf_repr_t inRepr,
+    uint16_t *pOutIdx, uint8_t *pOutBuffer, size_t outSize, lcsf_repr_t outRepr) {
+    lcsf_raw_msg_t msg;
+    lcsf_raw_att_t att;
+
+    // Convert the message header
+    if (!LCSF_FetchMsgHeader(pInIdx, inSize, pInBuffer, &msg, inRepr)) {
+        return false;
+    }
+    if (msg.ProtId == ((inRepr == LCSF_REPR_SMALL) ? LCSF_ERROR_PROTOCOL_ID_SMALL : LCSF_ERROR_PROTOCOL_ID)) {
+        msg.ProtId = (outRepr == LCSF_REPR_SMALL) ? LCSF_ERROR_PROTOCOL_ID_SMALL : LCSF_ERROR_PROTOCOL_ID;
+    }
+    if (!LCSF_FillMsgHeader(pOutIdx, pOutBuffer, outSize, &msg, outRepr)) {
+        return false;
+    }
+    // Convert the attributes
+    uint32_t attLeftNb = msg.AttNb;
+    while (attLeftNb > 0) {
+        attLeftNb--;
+        if (!LCSF_FetchAttHeader(pInIdx, inSize, pInBuffer, &att, inRepr)) {
+            return false;
+        }
+        if (att.HasSubAtt) {
+            // Sub-attributes follow
+            attLeftNb += att.PayloadSize;
+        } else if (!LCSF_FetchAttData(pInIdx, inSize, pInBuffer, att.PayloadSize, &att.Payload.pData)) {
+            return false;
+        }
+        if (!LCSF_FillAttHeader(pOutIdx, pOutBuffer, outSize, &att, outRepr)) {
+            return false;
+        }
+        if (!att.HasSubAtt && !LCSF_FillAttData(pOutIdx, pOutBuffer, outSize, &att)) {
+            return false;
+        }
+    }
+    // Leftover data
+    return (*pInIdx == inSize);
+}
+
 // *** Public Functions ***
 
 bool LCSF_TranscoderInit(void) {
     // Lifo creation
+#ifdef LCSF_SHARED_ARENA
+    return LifoInitRegion(&LcsfTranscoderInfo.DecoderLifo, &LcsfSharedArena, sizeof(lcsf_raw_att_t));
+#else
     return LifoInit(&LcsfTranscoderInfo.DecoderLifo, DecoderLifoData, LCSF_TRANSCODER_RX_LIFO_SIZE, sizeof(lcsf_raw_att_t));
+#endif
+}
+
+bool LCSF_TranscoderSetRoutes(const lcsf_route_t *pRouteArray, size_t routeNb) {
+    // Bad parameters guard
+    if (routeNb > UINT16_MAX) {
+        return false;
+    }
+    // Note routing table
+    LcsfTranscoderInfo.pRouteArray = pRouteArray;
+    LcsfTranscoderInfo.RouteNb = (pRouteArray != NULL) ? (uint16_t)routeNb : 0;
+    return true;
 }
 
 lcsf_receive_status_t LCSF_TranscoderReceive(const uint8_t *pBuffer, size_t buffSize) {
+    return LCSF_TranscoderReceiveRepr(pBuffer, buffSize, LCSF_REPR_DEFAULT);
+}
+
+lcsf_receive_status_t LCSF_TranscoderReceiveRepr(const uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr) {
     // Invalid parameters guards
     if (pBuffer == NULL) {
         return LCSF_RECEIVE_ERROR;
     }
+    if ((repr != LCSF_REPR_STANDARD) && (repr != LCSF_REPR_SMALL)) {
+        return LCSF_RECEIVE_ERROR;
+    }
+    lcsf_receive_status_t status;
+    // Forward routed messages as is
+    const lcsf_route_t *pRoute = LCSF_FindRoute(pBuffer, buffSize, repr);
+    if (pRoute != NULL) {
+        if ((pRoute->pFnForward == NULL) || !pRoute->pFnForward(pBuffer, buffSize)) {
+            status = LCSF_RECEIVE_ERROR;
+        } else {
+            status = LCSF_RECEIVE_FORWARDED;
+        }
+        return status;
+    }
     lcsf_raw_msg_t *pMsg = &LcsfTranscoderInfo.DecoderMsg;
     // Decode buffer into lcsf object
-    if (!LCSF_DecodeBuffer(pBuffer, buffSize, pMsg)) {
-        // Encode error buffer
-        LCSF_ValidatorSendTranscoderError(LcsfTranscoderInfo.LastErrCode);
-        return LCSF_RECEIVE_ERROR;
+    if (!LCSF_DecodeBuffer(pBuffer, buffSize, repr, pMsg)) {
+        // Release lifo memory before sending the error
+        LifoFreeAll(&LcsfTranscoderInfo.DecoderLifo);
+        if (LcsfTranscoderInfo.HeaderStatus != LCSF_RECEIVE_OK) {
+            // Header rejected, validator already sent the error
+            status = LcsfTranscoderInfo.HeaderStatus;
+        } else {
+            // Encode error buffer
+            LCSF_ValidatorSendTranscoderError(LcsfTranscoderInfo.LastErrCode, repr);
+            status = LCSF_RECEIVE_ERROR;
+        }
+        return status;
     }
-    // Send lcsf object to receiver
-    return LCSF_ValidatorReceive(pMsg);
+    // Send lcsf object to receiver, unless already processed from its fixed layout
+    if (LcsfTranscoderInfo.IsProcessed) {
+        status = LcsfTranscoderInfo.HeaderStatus;
+    } else {
+        status = LCSF_ValidatorReceiveRepr(pMsg, repr);
+    }
+    // Free lifo
+    LifoFreeAll(&LcsfTranscoderInfo.DecoderLifo);
+    return status;
 }
 
 int LCSF_TranscoderEncode(const lcsf_raw_msg_t *pMessage, uint8_t *pBuffer, size_t buffSize) {
+    return LCSF_TranscoderEncodeRepr(pMessage, pBuffer, buffSize, LCSF_REPR_DEFAULT);
+}
+
+int LCSF_TranscoderEncodeRepr(const lcsf_raw_msg_t *pMessage, uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr) {
     // Invalid parameters guards
     if (pMessage == NULL) {
         return -1;
@@ -514,11 +750,36 @@ int LCSF_TranscoderEncode(const lcsf_raw_msg_t *pMessage, uint8_t *pBuffer, size
     if (pBuffer == NULL) {
         return -1;
     }
+    if ((repr != LCSF_REPR_STANDARD) && (repr != LCSF_REPR_SMALL)) {
+        return -1;
+    }
     uint16_t msgSize = 0;
     // Encode lcsf object into send buffer
-    if (!LCSF_EncodeBuffer(&msgSize, pBuffer, buffSize, pMessage)) {
+    if (!LCSF_EncodeBuffer(&msgSize, pBuffer, buffSize, repr, pMessage)) {
         return -1;
     }
     // Return encoded message size
     return msgSize;
 }
+
+int LCSF_TranscoderConvert(const uint8_t *pInBuffer, size_t inSize, lcsf_repr_t inRepr, uint8_t *pOutBuffer,
+    size_t outSize, lcsf_repr_t outRepr) {
+    // Invalid parameters guards
+    if ((pInBuffer == NULL) || (pOutBuffer == NULL)) {
+        return -1;
+    }
+    if ((inRepr != LCSF_REPR_STANDARD) && (inRepr != LCSF_REPR_SMALL)) {
+        return -1;
+    }
+    if ((outRepr != LCSF_REPR_STANDARD) && (outRepr != LCSF_REPR_SMALL)) {
+        return -1;
+    }
+    uint16_t inIdx = 0;
+    uint16_t outIdx = 0;
+    // Convert message
+    if (!LCSF_ConvertBuffer(&inIdx, pInBuffer, inSize, inRepr, &outIdx, pOutBuffer, outSize, outRepr)) {
+        return -1;
+    }
+    // Return converted message size
+    return outIdx;
+}
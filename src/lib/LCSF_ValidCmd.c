@@ -0,0 +1,245 @@
+/**
+ * \file LCSF_ValidCmd.c
+ * \brief Light Command Set Format valid command module, detaches validated commands into relocatable blobs
+ * \author Jean-Roland Gosse
+ *
+ * This file is part of LCSF C Stack.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ */
+
+// *** Libraries include ***
+// Standard lib
+#include <string.h>
+// Custom lib
+#include <LCSF_Config.h>
+#include <lib/LCSF_ValidCmd.h>
+
+// *** Definitions ***
+// --- Private Types ---
+
+// Detached blob cursor structure
+typedef struct _lcsf_detach_cursor {
+    uint8_t *pBlob; // Pointer to the blob
+    size_t ArrayIdx; // Offset of the next attribute array
+    size_t DataIdx; // Offset of the next payload bytes
+} lcsf_detach_cursor_t;
+
+// --- Private Constants ---
+#define LCSF_DETACH_HEADER_SIZE sizeof(lcsf_detached_cmd_t)
+#define LCSF_DETACH_ATT_SIZE sizeof(lcsf_valid_att_t)
+#define LCSF_DETACH_ALIGN sizeof(void *)
+#define LCSF_DETACH_MAX_SIZE 0x7FFFFFFF // Blob size must fit the int return value
+
+// --- Private Function Prototypes ---
+static bool LCSF_GetDetachSize_Rec(uint_fast16_t attNb, const lcsf_valid_att_t *pAttArray,
+    const lcsf_attribute_desc_t *pAttDescArray, size_t *pArraySize, size_t *pDataSize);
+static size_t LCSF_DetachAtt_Rec(uint_fast16_t attNb, const lcsf_valid_att_t *pAttArray,
+    const lcsf_attribute_desc_t *pAttDescArray, lcsf_detach_cursor_t *pCursor);
+static bool LCSF_AttachAtt_Rec(uint8_t *pBlob, size_t blobSize, size_t arrayIdx, uint_fast16_t attNb,
+    const lcsf_attribute_desc_t *pAttDescArray, lcsf_valid_att_t **pAttArray);
+
+// --- Private Variables ---
+// *** End Definitions ***
+
+// *** Private Functions ***
+
+/**
+ * \fn static bool LCSF_GetDetachSize_Rec(uint_fast16_t attNb, const lcsf_valid_att_t *pAttArray, const lcsf_attribute_desc_t *pAttDescArray, size_t *pArraySize, size_t *pDataSize)
+ * \brief Compute recursively the size of the attribute arrays and payload bytes of a command
+ *
+ * \param attNb number of attributes in the descriptor array
+ * \param pAttArray pointer to the valid attribute array
+ * \param pAttDescArray pointer to the attribute descriptor array
+ * \param pArraySize pointer to the attribute arrays size to increment
+ * \param pDataSize pointer to the payload bytes size to increment
+ * \return bool: true if operation was a success
+ */
+static bool LCSF_GetDetachSize_Rec(uint_fast16_t attNb, const lcsf_valid_att_t *pAttArray,
+    const lcsf_attribute_desc_t *pAttDescArray, size_t *pArraySize, size_t *pDataSize) {
+    if (attNb == 0) {
+        return true;
+    }
+    if ((pAttArray == NULL) || (pAttDescArray == NULL)) {
+        return false;
+    }
+    *pArraySize += attNb * LCSF_DETACH_ATT_SIZE;
+    for (uint16_t idx = 0; idx < attNb; idx++) {
+        const lcsf_valid_att_t *pAtt = &(pAttArray[idx]);
+        // Skip absent attributes
+        if (pAtt->Payload.pData == NULL) {
+            continue;
+        }
+        const lcsf_attribute_desc_t *pAttDesc = &(pAttDescArray[idx]);
+        if (pAttDesc->DataType == LCSF_SUB_ATTRIBUTES) {
+            if (!LCSF_GetDetachSize_Rec(pAttDesc->SubAttNb, pAtt->Payload.pSubAttArray, pAttDesc->pSubAttDescArray,
+                    pArraySize, pDataSize)) {
+                return false;
+            }
+        } else {
+            *pDataSize += pAtt->PayloadSize;
+        }
+        if ((*pArraySize + *pDataSize) > LCSF_DETACH_MAX_SIZE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * \fn static size_t LCSF_DetachAtt_Rec(uint_fast16_t attNb, const lcsf_valid_att_t *pAttArray, const lcsf_attribute_desc_t *pAttDescArray, lcsf_detach_cursor_t *pCursor)
+ * \brief Copy recursively an attribute array and its payloads into a blob, pointers are replaced by offsets
+ *
+ * \param attNb number of attributes in the descriptor array
+ * \param pAttArray pointer to the valid attribute array
+ * \param pAttDescArray pointer to the attribute descriptor array
+ * \param pCursor pointer to the blob cursor
+ * \return size_t: offset of the copied attribute array
+ */
+static size_t LCSF_DetachAtt_Rec(uint_fast16_t attNb, const lcsf_valid_att_t *pAttArray,
+    const lcsf_attribute_desc_t *pAttDescArray, lcsf_detach_cursor_t *pCursor) {
+    // Reserve the array, sub-attribute arrays follow their parent
+    size_t arrayIdx = pCursor->ArrayIdx;
+    pCursor->ArrayIdx += attNb * LCSF_DETACH_ATT_SIZE;
+    for (uint16_t idx = 0; idx < attNb; idx++) {
+        const lcsf_valid_att_t *pAtt = &(pAttArray[idx]);
+        lcsf_valid_att_t detachedAtt;
+        detachedAtt.PayloadSize = pAtt->PayloadSize;
+        detachedAtt.Payload.pData = NULL;
+        if (pAtt->Payload.pData != NULL) {
+            const lcsf_attribute_desc_t *pAttDesc = &(pAttDescArray[idx]);
+            size_t payloadIdx;
+            if (pAttDesc->DataType == LCSF_SUB_ATTRIBUTES) {
+                payloadIdx = LCSF_DetachAtt_Rec(
+                    pAttDesc->SubAttNb, pAtt->Payload.pSubAttArray, pAttDesc->pSubAttDescArray, pCursor);
+            } else {
+                payloadIdx = pCursor->DataIdx;
+                memcpy(&(pCursor->pBlob[payloadIdx]), pAtt->Payload.pData, pAtt->PayloadSize);
+                pCursor->DataIdx += pAtt->PayloadSize;
+            }
+            detachedAtt.Payload.pData = (void *)(uintptr_t)payloadIdx;
+        }
+        memcpy(&(pCursor->pBlob[arrayIdx + idx * LCSF_DETACH_ATT_SIZE]), &detachedAtt, LCSF_DETACH_ATT_SIZE);
+    }
+    return arrayIdx;
+}
+
+/**
+ * \fn static bool LCSF_AttachAtt_Rec(uint8_t *pBlob, size_t blobSize, size_t arrayIdx, uint_fast16_t attNb, const lcsf_attribute_desc_t *pAttDescArray, lcsf_valid_att_t **pAttArray)
+ * \brief Check recursively an attribute array of a blob and turn its offsets into pointers
+ *
+ * \param pBlob pointer to the blob
+ * \param blobSize blob size
+ * \param arrayIdx offset of the attribute array
+ * \param attNb number of attributes in the descriptor array
+ * \param pAttDescArray pointer to the attribute descriptor array
+ * \param pAttArray pointer to contain the attribute array
+ * \return bool: true if the offsets stay in the blob
+ */
+static bool LCSF_AttachAtt_Rec(uint8_t *pBlob, size_t blobSize, size_t arrayIdx, uint_fast16_t attNb,
+    const lcsf_attribute_desc_t *pAttDescArray, lcsf_valid_att_t **pAttArray) {
+    // Array alignment and overflow guard
+    if ((arrayIdx < LCSF_DETACH_HEADER_SIZE) || ((arrayIdx % LCSF_DETACH_ALIGN) != 0) || (arrayIdx > blobSize) ||
+        ((attNb * LCSF_DETACH_ATT_SIZE) > (blobSize - arrayIdx))) {
+        return false;
+    }
+    *pAttArray = (lcsf_valid_att_t *)&(pBlob[arrayIdx]);
+    for (uint16_t idx = 0; idx < attNb; idx++) {
+        lcsf_valid_att_t *pAtt = &((*pAttArray)[idx]);
+        // Skip absent attributes
+        if (pAtt->Payload.pData == NULL) {
+            continue;
+        }
+        const lcsf_attribute_desc_t *pAttDesc = &(pAttDescArray[idx]);
+        size_t payloadIdx = (size_t)(uintptr_t)pAtt->Payload.pData;
+        if (pAttDesc->DataType == LCSF_SUB_ATTRIBUTES) {
+            if (!LCSF_AttachAtt_Rec(pBlob, blobSize, payloadIdx, pAttDesc->SubAttNb, pAttDesc->pSubAttDescArray,
+                    &(pAtt->Payload.pSubAttArray))) {
+                return false;
+            }
+        } else {
+            // Payload overflow guard
+            if ((payloadIdx < LCSF_DETACH_HEADER_SIZE) || (payloadIdx > blobSize) ||
+                (pAtt->PayloadSize > (blobSize - payloadIdx))) {
+                return false;
+            }
+            pAtt->Payload.pData = &(pBlob[payloadIdx]);
+        }
+    }
+    return true;
+}
+
+// *** Public Functions ***
+
+int LCSF_ValidCmdGetDetachSize(const lcsf_valid_cmd_t *pCmd, const lcsf_command_desc_t *pDesc) {
+    // Bad parameters guard
+    if ((pCmd == NULL) || (pDesc == NULL)) {
+        return -1;
+    }
+    size_t arraySize = 0;
+    size_t dataSize = 0;
+    if (!LCSF_GetDetachSize_Rec(pDesc->AttNb, pCmd->pAttArray, pDesc->pAttDescArray, &arraySize, &dataSize)) {
+        return -1;
+    }
+    return (int)(LCSF_DETACH_HEADER_SIZE + arraySize + dataSize);
+}
+
+int LCSF_ValidCmdDetach(const lcsf_valid_cmd_t *pCmd, const lcsf_command_desc_t *pDesc, uint8_t *pOut, size_t outSize) {
+    // Bad parameters guard
+    if ((pCmd == NULL) || (pDesc == NULL) || (pOut == NULL) || ((((uintptr_t)pOut) % LCSF_DETACH_ALIGN) != 0)) {
+        return -1;
+    }
+    size_t arraySize = 0;
+    size_t dataSize = 0;
+    if (!LCSF_GetDetachSize_Rec(pDesc->AttNb, pCmd->pAttArray, pDesc->pAttDescArray, &arraySize, &dataSize)) {
+        return -1;
+    }
+    size_t blobSize = LCSF_DETACH_HEADER_SIZE + arraySize + dataSize;
+    // Buffer overflow guard
+    if (blobSize > outSize) {
+        return -1;
+    }
+    lcsf_detached_cmd_t header;
+    header.CmdId = pCmd->CmdId;
+    header.AttNb = pDesc->AttNb;
+    header.BlobSize = (uint32_t)blobSize;
+    memcpy(pOut, &header, LCSF_DETACH_HEADER_SIZE);
+    // Attribute arrays first to keep them aligned, payload bytes last
+    lcsf_detach_cursor_t cursor;
+    cursor.pBlob = pOut;
+    cursor.ArrayIdx = LCSF_DETACH_HEADER_SIZE;
+    cursor.DataIdx = LCSF_DETACH_HEADER_SIZE + arraySize;
+    (void)LCSF_DetachAtt_Rec(pDesc->AttNb, pCmd->pAttArray, pDesc->pAttDescArray, &cursor);
+    return (int)blobSize;
+}
+
+bool LCSF_ValidCmdAttach(uint8_t *pBlob, size_t blobSize, const lcsf_command_desc_t *pDesc, lcsf_valid_cmd_t *pCmd) {
+    // Bad parameters guard
+    if ((pBlob == NULL) || (pDesc == NULL) || (pCmd == NULL) || ((((uintptr_t)pBlob) % LCSF_DETACH_ALIGN) != 0)) {
+        return false;
+    }
+    // Header guard
+    const lcsf_detached_cmd_t *pHeader = (const lcsf_detached_cmd_t *)pBlob;
+    if ((blobSize < LCSF_DETACH_HEADER_SIZE) || (pHeader->BlobSize != blobSize) || (pHeader->CmdId != pDesc->CmdId) ||
+        (pHeader->AttNb != pDesc->AttNb)) {
+        return false;
+    }
+    pCmd->CmdId = pHeader->CmdId;
+    pCmd->pAttArray = NULL;
+    if (pDesc->AttNb == 0) {
+        return true;
+    }
+    return LCSF_AttachAtt_Rec(
+        pBlob, blobSize, LCSF_DETACH_HEADER_SIZE, pDesc->AttNb, pDesc->pAttDescArray, &(pCmd->pAttArray));
+}
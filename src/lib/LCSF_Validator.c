@@ -24,6 +24,7 @@
 #include <string.h>
 // Custom lib
 #include <LCSF_Config.h>
+#include <lib/LCSF_Atomic.h>
 #include <lib/LCSF_Transcoder.h>
 #include <lib/LCSF_Validator.h>
 #include <lib/Lifo.h>
@@ -31,19 +32,9 @@
 // *** Definitions ***
 // --- Private Types ---
 
-// Error buffer size
-#ifdef LCSF_SMALL
-#define ERR_BUFF_SIZE 10
-#else
+// Error buffer size (standard representation, the smaller one needs 10 bytes)
 #define ERR_BUFF_SIZE 18
-#endif
 
-// Lcsf error protocol (LCSF_EP) id (0xFF in the smaller representation to fit the 8-bit id field)
-#ifdef LCSF_SMALL
-#define LCSF_ERROR_PROTOCOL_ID 0x00FF
-#else
-#define LCSF_ERROR_PROTOCOL_ID 0xFFFF
-#endif
 // Lcsf error protocol (LCSF_EP) version
 #define LCSF_ERROR_PROTOCOL_VERSION 0x00
 
@@ -90,57 +81,231 @@ typedef struct _lcsf_ep_cmd_error_desc {
     uint8_t ErrorType;
 } lcsf_ep_cmd_error_desc_t;
 
-// Lifo data buffers
-static uint8_t ReceiverLifoData[LCSF_VALIDATOR_RX_LIFO_SIZE * sizeof(lcsf_valid_att_t)];
+#if defined(LCSF_SHARED_ARENA) && (LCSF_VALIDATOR_RX_GEN_NB > 1)
+#error "Receiver lifo generations can't be held in the shared arena, set LCSF_VALIDATOR_RX_GEN_NB to 1"
+#endif
+
+#ifndef LCSF_SHARED_ARENA
+// Lifo data buffers, one receiver lifo per generation
+static uint8_t ReceiverLifoData[LCSF_VALIDATOR_RX_GEN_NB][LCSF_VALIDATOR_RX_LIFO_SIZE * sizeof(lcsf_valid_att_t)];
 static uint8_t SenderLifoData[LCSF_VALIDATOR_TX_LIFO_SIZE * sizeof(lcsf_raw_att_t)];
+#endif
+
+// Sparse attribute array presence word, stored in a region of lifo items leading a sparse array
+typedef struct _lcsf_sparse_word {
+    uint32_t Bitmap; // Presence bits of 32 descriptor attributes
+    uint32_t Rank; // Number of present attributes in the previous words
+} lcsf_sparse_word_t;
+
+// The word region is only accessed as words, the attributes start at the item following it
+_Static_assert(sizeof(lcsf_sparse_word_t) <= sizeof(lcsf_valid_att_t), "Sparse word larger than an attribute");
+_Static_assert(_Alignof(lcsf_sparse_word_t) <= _Alignof(lcsf_valid_att_t), "Sparse word misaligned in the lifo");
+
+// Number of presence words of a sparse attribute array
+#define LCSF_SPARSE_WORD_NB(descAttNb) (((descAttNb) + 31) / 32)
+// Number of lifo items of the presence word region of a sparse attribute array
+#define LCSF_SPARSE_ITEM_NB(descAttNb)                                                                                 \
+    ((LCSF_SPARSE_WORD_NB(descAttNb) * sizeof(lcsf_sparse_word_t) + sizeof(lcsf_valid_att_t) - 1) /                    \
+        sizeof(lcsf_valid_att_t))
+
+// Attribute descriptor level, pointer-based descriptors or packed records
+typedef struct _lcsf_att_level {
+    const lcsf_attribute_desc_t *pAttDescArray; // Pointer to the attribute descriptor array, NULL with packed records
+    const lcsf_packed_att_desc_t *pPackedArray; // Pointer to the attribute record array, NULL with descriptors
+    uint16_t AttIdx; // Index of the level first record (packed records only)
+    uint16_t AttNb; // Number of attributes of the level
+} lcsf_att_level_t;
+
+// Attribute descriptor fields, read from either descriptor representation
+typedef struct _lcsf_att_info {
+    uint16_t AttId; // Attribute identifier
+    uint8_t DataType; // Attribute data type
+    bool IsOptional; // Indicates if the attribute is optional
+    lcsf_att_level_t SubLevel; // Sub-attribute level
+} lcsf_att_info_t;
+
+// Lcsf error message template, encoded by the first error sent in a representation, only its data then changes
+typedef struct _lcsf_err_template {
+    uint8_t Buffer[ERR_BUFF_SIZE]; // Buffer to contain encoded error message
+    lcsf_prepared_att_t AttArray[LCSF_EP_CMD_ERROR_ATT_NB]; // Error message attribute layout
+    lcsf_prepared_cmd_t Prepared; // Error message layout
+    bool IsEncoded; // Indicates if the template was encoded
+} lcsf_err_template_t;
+
+// Fixed layout command, only non-optional fixed size attributes, received without attribute decoding
+typedef struct _lcsf_fixed_cmd {
+    const lcsf_command_desc_t *pCmdDesc; // Pointer to the command descriptor
+    uint16_t ProtIdx; // Index of the protocol
+    uint16_t DataSize; // Sum of the attribute data sizes
+} lcsf_fixed_cmd_t;
+
+// Protocol registry snapshot, never modified once published
+typedef struct _lcsf_registry {
+    const lcsf_validator_protocol_desc_t *pProtArray[LCSF_VALIDATOR_PROTOCOL_NB]; // Module protocol array
+    const uint8_t *pCmdFilterArray[LCSF_VALIDATOR_PROTOCOL_NB]; // Optional bitmaps of the subscribed command ids
+    uint16_t CmdFilterSizeArray[LCSF_VALIDATOR_PROTOCOL_NB]; // Number of command ids in the bitmaps
+    bool IsTrustedArray[LCSF_VALIDATOR_PROTOCOL_NB]; // Indicates if messages are first mapped by position
+    lcsf_fixed_cmd_t FixedCmdArray[LCSF_VALIDATOR_FIXED_CMD_NB]; // Commands received without attribute decoding
+    uint16_t FixedCmdNb; // Number of fixed layout commands
+    uint32_t Generation; // Incremented at each publication
+} lcsf_registry_t;
+
+// Registry readers, the sends nested in a receive (replies) keep their own read section
+enum _lcsf_registry_reader_enum {
+    LCSF_READER_RX = 0x00,
+    LCSF_READER_TX = 0x01,
+    LCSF_READER_NB,
+};
+
+// Registry reader state
+typedef struct _lcsf_registry_reader {
+    LCSF_ATOMIC(uint32_t) ReadSeq; // Reader sequence, odd while the reader holds a snapshot
+    uint32_t PublishSeq; // Reader sequence noted at the last publication
+    const lcsf_registry_t *pRegistry; // Snapshot held by the reader
+    uint16_t Depth; // Nesting depth of the reader sections
+} lcsf_registry_reader_t;
+
+#if (LCSF_VALIDATOR_SHAPE_CACHE_NB > 0)
+// Memoized message shape attribute, raw attributes are noted in depth-first order
+typedef struct _lcsf_shape_att {
+    uint16_t AttId:15; // Attribute identifier
+    uint16_t HasSubAtt:1; // Indicates if the attribute has sub attributes or data
+    uint16_t PayloadSize; // Data size (bytes) or sub attribute number
+    uint16_t DescIdx; // Index of the matching attribute descriptor
+} lcsf_shape_att_t;
+
+// Memoized message shape, validated once against its command descriptor
+typedef struct _lcsf_shape {
+    const lcsf_command_desc_t *pCmdDesc; // Pointer to the command descriptor, NULL if the entry is free
+    uint32_t Hash; // Hash of the attribute ids, flags and sizes
+    uint16_t AttNb; // Number of attributes, sub-attributes included
+    lcsf_shape_att_t AttArray[LCSF_VALIDATOR_SHAPE_ATT_NB]; // Shape attributes
+} lcsf_shape_t;
+#endif
 
 // Module information structure
 typedef struct _lcsf_validator_info {
     // Lifo desc
-    lifo_desc_t ReceiverLifo; // Structure ot the receiver lifo
+    lifo_desc_t ReceiverLifoArray[LCSF_VALIDATOR_RX_GEN_NB]; // Structures of the receiver lifo generations
+    lifo_desc_t *pReceiverLifo; // Receiver lifo of the current message
     lifo_desc_t SenderLifo; // Structure of the sender lifo
-    // Protocol array
-    const lcsf_validator_protocol_desc_t
-        *pProtArray[LCSF_VALIDATOR_PROTOCOL_NB]; // Pointer to contain the module protocol array
+    // Protocol registry
+    lcsf_registry_t RegistryArray[2]; // Published and spare registry snapshots
+    LCSF_ATOMIC(lcsf_registry_t *) pRegistry; // Published registry snapshot
+    lcsf_registry_reader_t ReaderArray[LCSF_READER_NB]; // Receive and send registry readers
+    uint16_t ProtNb; // Number of protocol handled by the module
+    // Receiver lifo generations
+    LCSF_ATOMIC(bool) IsHeldArray[LCSF_VALIDATOR_RX_GEN_NB]; // Indicates if a generation holds a command
+    bool IsInterpretingArray[LCSF_VALIDATOR_RX_GEN_NB]; // Indicates if a generation message is being interpreted
+    uint16_t RxGenIdx; // Generation of the current message
+    lcsf_repr_t SendRepr; // Representation of the sent messages, the one of the message being interpreted
     // Callbacks
     LCSFSendErrCallback_t *pFnSendErrCb; // Optional function pointer to send lcsf error messages
     LCSFReceiveErrCallback_t *pFnRecErrCb; // Optional function pointer to receive lcsf error messages
-    uint16_t ProtNb; // Number of protocol handled by the module
+#if (LCSF_VALIDATOR_SHAPE_CACHE_NB > 0)
+    // Shape cache
+    lcsf_shape_t ShapeArray[LCSF_VALIDATOR_SHAPE_CACHE_NB]; // Memoized message shapes
+    uint16_t NextShapeIdx; // Index of the next shape to replace
+    uint32_t ShapeGeneration; // Registry generation the shapes were validated against
+    lcsf_shape_cache_stats_t ShapeStats; // Shape cache statistics
+#endif
     // Error values
     uint8_t LastErrorType; // Contains the last error the module encountered
-    uint8_t Err_buff[ERR_BUFF_SIZE]; // Buffer to contain encoded error message
+    lcsf_err_template_t ErrTemplateArray[LCSF_REPR_SMALL + 1]; // Error message templates per representation
 } lcsf_validator_info_t;
 
 // --- Private Constants ---
 // --- Private Function Prototypes ---
 // Utility functions
 static bool LCSF_AllocateReceiverAttArray(uint_fast16_t attNb, lcsf_valid_att_t **pAttArray);
+static bool LCSF_SelectReceiverGen(void);
+static void LCSF_ReleaseReceiverGen(void);
+static void LCSF_RestoreReceiverGen(uint_fast16_t genIdx);
+static bool LCSF_InterpretCmd(LCSFInterpretCallback_t *pFnInterpreter, lcsf_valid_cmd_t *pValidCmd, lcsf_repr_t repr);
 static bool LCSF_AllocateSenderAttArray(uint_fast16_t attNb, lcsf_raw_att_t **pAttArray);
-static const lcsf_validator_protocol_desc_t *LCSF_GetProtEntry(uint_fast16_t protId);
+static uint16_t LCSF_GetErrorProtocolId(lcsf_repr_t repr);
+static const lcsf_validator_protocol_desc_t *LCSF_GetProtEntry(
+    const lcsf_registry_t *pRegistry, uint_fast16_t protId);
 static lcsf_receive_status_t LCSF_MapValidationError(uint_fast8_t errType);
+static bool LCSF_IsCmdFiltered(const lcsf_registry_t *pRegistry, uint_fast16_t protId, uint_fast16_t cmdId);
+static bool LCSF_IsProtTrusted(const lcsf_registry_t *pRegistry, uint_fast16_t protId);
+static LCSFInterpretCallback_t *LCSF_GetCmdHandler(const lcsf_validator_protocol_desc_t *pProt, uint_fast16_t cmdIdx);
+// Registry functions
+static const lcsf_registry_t *LCSF_EnterRegistry(uint_fast8_t readerIdx);
+static void LCSF_LeaveRegistry(uint_fast8_t readerIdx);
+static lcsf_registry_t *LCSF_BeginRegistryUpdate(void);
+static void LCSF_PublishRegistry(lcsf_registry_t *pRegistry);
+// Fixed layout functions
+static uint_fast8_t LCSF_GetFixedDataSize(uint_fast8_t descDataType);
+static void LCSF_AddFixedCommands(
+    lcsf_registry_t *pRegistry, uint_fast16_t protIdx, const lcsf_protocol_desc_t *pProtDesc);
+static const lcsf_fixed_cmd_t *LCSF_FindFixedCmd(const lcsf_registry_t *pRegistry, const lcsf_command_desc_t *pCmdDesc);
 // Table look up functions
 static bool LCSF_ValidateCmdId(
     uint_fast16_t cmdId, uint_fast16_t cmdNb, uint16_t *pCmdIdx, const lcsf_command_desc_t *pCmdDescArray);
-static bool LCSF_HasNonOptionalAttribute(uint_fast16_t attNb, const lcsf_attribute_desc_t *pAttDescArray);
+static bool LCSF_ValidatePackedCmdId(
+    uint_fast16_t cmdId, const lcsf_packed_prot_desc_t *pPackedDesc, uint16_t *pCmdIdx);
+static bool LCSF_ValidateProtCmdId(
+    const lcsf_validator_protocol_desc_t *pProt, uint_fast16_t cmdId, uint16_t *pCmdIdx);
+static void LCSF_GetAttLevel(
+    const lcsf_validator_protocol_desc_t *pProt, uint_fast16_t cmdIdx, lcsf_att_level_t *pLevel);
+static void LCSF_GetAttDesc(const lcsf_att_level_t *pLevel, uint_fast16_t idx, lcsf_att_info_t *pInfo);
+static bool LCSF_HasNonOptionalAttribute(const lcsf_att_level_t *pLevel);
 static bool LCSF_RecogniseAttributeId(
     uint_fast16_t attId, uint_fast16_t attNb, uint16_t *pAttIdx, const lcsf_raw_att_t *pAttArray);
 static uint16_t LCSF_CountAttributes(uint_fast16_t descAttNb, lcsf_valid_att_t *pAttArray);
 // Receiver functions
+static bool LCSF_ValidateHeader(const lcsf_registry_t *pRegistry, const lcsf_raw_msg_t *pMessage,
+    const lcsf_validator_protocol_desc_t **pProtEntry, uint16_t *pCmdIdx);
+static lcsf_receive_status_t LCSF_ReadCheckHeader(
+    const lcsf_registry_t *pRegistry, const lcsf_raw_msg_t *pMessage, lcsf_repr_t repr);
+static bool LCSF_ReadReceiveFixed(const lcsf_registry_t *pRegistry, const lcsf_raw_msg_t *pMessage,
+    const uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr, lcsf_receive_status_t *pStatus);
+static lcsf_receive_status_t LCSF_ReadReceive(
+    const lcsf_registry_t *pRegistry, const lcsf_raw_msg_t *pMessage, lcsf_repr_t repr);
 static bool LCSF_ValidateDataType(size_t dataSize, uint_fast8_t descDataType);
-static bool LCSF_ValidateAttribute_Rec(uint_fast16_t attNb, const lcsf_raw_att_t *pAttArray, uint_fast16_t descAttNb,
-    const lcsf_attribute_desc_t *pAttDescArray, lcsf_valid_att_t **pValidAttArray);
-static bool LCSF_ValidateAttribute(
+static uint_fast8_t LCSF_CountBits(uint32_t word);
+static bool LCSF_ValidateAttribute_Rec(uint_fast16_t attNb, const lcsf_raw_att_t *pAttArray,
+    const lcsf_att_level_t *pLevel, bool isSparse, lcsf_valid_att_t **pValidAttArray);
+static bool LCSF_ValidateAttribute(const lcsf_raw_msg_t *pMessage, const lcsf_validator_protocol_desc_t *pProt,
+    uint_fast16_t cmdIdx, lcsf_valid_att_t **pValidAttArray);
+static bool LCSF_MapTrustedAttribute_Rec(uint_fast16_t attNb, const lcsf_raw_att_t *pAttArray,
+    uint_fast16_t descAttNb, const lcsf_attribute_desc_t *pAttDescArray, lcsf_valid_att_t **pValidAttArray);
+static bool LCSF_MapTrustedAttribute(
     const lcsf_raw_msg_t *pMessage, const lcsf_command_desc_t *pCmdDesc, lcsf_valid_att_t **pValidAttArray);
+#if (LCSF_VALIDATOR_SHAPE_CACHE_NB > 0)
+// Shape cache functions
+static bool LCSF_HashShape_Rec(uint_fast16_t attNb, const lcsf_raw_att_t *pAttArray, uint32_t *pHash, uint16_t *pAttNb);
+static bool LCSF_StoreShape_Rec(uint_fast16_t attNb, const lcsf_raw_att_t *pAttArray, uint_fast16_t descAttNb,
+    const lcsf_attribute_desc_t *pAttDescArray, lcsf_shape_t *pShape);
+static bool LCSF_ValidateShape_Rec(uint_fast16_t attNb, const lcsf_raw_att_t *pAttArray, uint_fast16_t descAttNb,
+    const lcsf_attribute_desc_t *pAttDescArray, lcsf_valid_att_t **pValidAttArray, const lcsf_shape_t *pShape,
+    uint16_t *pShapeIdx);
+static bool LCSF_ValidateCachedAttribute(
+    const lcsf_raw_msg_t *pMessage, const lcsf_command_desc_t *pCmdDesc, lcsf_valid_att_t **pValidAttArray);
+#endif
 // Sender functions
 static bool LCSF_FillAttributeInfo(
     lcsf_raw_att_t *pRawAtt, uint_fast8_t descDataType, uint_fast16_t subAttNb, const lcsf_valid_att_t *pValidAtt);
-static bool LCSF_FillAttribute_Rec(uint_fast16_t descAttNb, const lcsf_attribute_desc_t *pAttDescArray,
-    const lcsf_valid_att_t *pValidAttArray, lcsf_raw_att_t *pRawAttArray);
+static bool LCSF_FillAttribute_Rec(
+    const lcsf_att_level_t *pLevel, const lcsf_valid_att_t *pValidAttArray, lcsf_raw_att_t *pRawAttArray);
 static bool LCSF_FillAttributeArray(uint_fast16_t attNb, const lcsf_valid_att_t *pAttArray,
-    const lcsf_command_desc_t *pCmdDesc, lcsf_raw_att_t **pRawAttArray);
+    const lcsf_att_level_t *pLevel, lcsf_raw_att_t **pRawAttArray);
+static bool LCSF_FillSendMsg(const lcsf_registry_t *pRegistry, uint_fast16_t protId, const lcsf_valid_cmd_t *pCommand,
+    lcsf_raw_msg_t *pSendMsg);
+// Prepared command functions
+static bool LCSF_PrepareAttribute_Rec(uint_fast16_t attNb, const lcsf_raw_att_t *pAttArray, size_t attHeaderSize,
+    size_t *pBuffIdx, lcsf_prepared_cmd_t *pPrepared, size_t attArraySize);
+static void LCSF_PatchPreparedData(const lcsf_prepared_cmd_t *pPrepared, const uint8_t *pValues, uint8_t *pBuffer);
 // Lcsf error processing functions
-static bool LCSF_ValidatorSendError(uint_fast8_t errorLoc, uint_fast8_t errorType);
+static bool LCSF_EncodeErrorTemplate(lcsf_repr_t repr, uint8_t *pValues);
+static bool LCSF_ValidatorSendError(uint_fast8_t errorLoc, uint_fast8_t errorType, lcsf_repr_t repr);
 static bool LCSF_ProcessReceivedError(const lcsf_raw_msg_t *pErrorMsg);
+// Descriptor usage functions
+static bool LCSF_PackAttDesc_Rec(uint_fast16_t attNb, const lcsf_attribute_desc_t *pAttDescArray,
+    uint_fast16_t levelIdx, lcsf_packed_att_desc_t *pAttArray, size_t attArraySize, size_t *pNextIdx);
+static uint32_t LCSF_GetAttDescUsage_Rec(
+    uint_fast16_t attNb, const lcsf_attribute_desc_t *pAttDescArray, uint_fast16_t depth, uint16_t *pMaxDepth);
 
 // --- Private Variables ---
 static lcsf_validator_info_t LcsfValidatorInfo;
@@ -158,7 +323,76 @@ static lcsf_validator_info_t LcsfValidatorInfo;
  * \return bool: true if operation was a success
  */
 static bool LCSF_AllocateReceiverAttArray(uint_fast16_t attNb, lcsf_valid_att_t **pAttArray) {
-    return LifoGet(&LcsfValidatorInfo.ReceiverLifo, attNb, (void **)pAttArray);
+    return LifoGet(LcsfValidatorInfo.pReceiverLifo, attNb, (void **)pAttArray);
+}
+
+/**
+ * \fn static bool LCSF_SelectReceiverGen(void)
+ * \brief Select the receiver lifo generation of a new message, the next one neither holding nor interpreting a command
+ *
+ * \return bool: true if operation was a success, false if all the generations are in use
+ */
+static bool LCSF_SelectReceiverGen(void) {
+    for (uint16_t idx = 1; idx <= LCSF_VALIDATOR_RX_GEN_NB; idx++) {
+        uint16_t genIdx = (LcsfValidatorInfo.RxGenIdx + idx) % LCSF_VALIDATOR_RX_GEN_NB;
+        if (!LCSF_ATOMIC_LOAD(&LcsfValidatorInfo.IsHeldArray[genIdx]) &&
+            !LcsfValidatorInfo.IsInterpretingArray[genIdx]) {
+            LcsfValidatorInfo.RxGenIdx = genIdx;
+            LcsfValidatorInfo.pReceiverLifo = &(LcsfValidatorInfo.ReceiverLifoArray[genIdx]);
+            LifoFreeAll(LcsfValidatorInfo.pReceiverLifo);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * \fn static void LCSF_ReleaseReceiverGen(void)
+ * \brief Release the receiver lifo of the current message, unless its command is held
+ *
+ * \return void
+ */
+static void LCSF_ReleaseReceiverGen(void) {
+    // Free lifo, unless the command is held
+    if (!LCSF_ATOMIC_LOAD(&LcsfValidatorInfo.IsHeldArray[LcsfValidatorInfo.RxGenIdx])) {
+        LifoFreeAll(LcsfValidatorInfo.pReceiverLifo);
+    }
+}
+
+/**
+ * \fn static void LCSF_RestoreReceiverGen(uint_fast16_t genIdx)
+ * \brief Restore the receiver lifo generation of the message received before, once a nested receive is over
+ *
+ * \param genIdx index of the generation to restore
+ * \return void
+ */
+static void LCSF_RestoreReceiverGen(uint_fast16_t genIdx) {
+    LcsfValidatorInfo.RxGenIdx = (uint16_t)genIdx;
+    LcsfValidatorInfo.pReceiverLifo = &(LcsfValidatorInfo.ReceiverLifoArray[genIdx]);
+}
+
+/**
+ * \fn static bool LCSF_InterpretCmd(LCSFInterpretCallback_t *pFnInterpreter, lcsf_valid_cmd_t *pValidCmd, lcsf_repr_t repr)
+ * \brief Send a validated command to its interpretation function, then release its receiver lifo generation
+ *
+ * The generation can't be selected by a message received from the interpretation function. The messages sent from
+ * the interpretation function use the representation of the command.
+ *
+ * \param pFnInterpreter pointer to the interpretation function
+ * \param pValidCmd pointer to the validated command
+ * \param repr representation the command was received in
+ * \return bool: true if the command was interpreted
+ */
+static bool LCSF_InterpretCmd(LCSFInterpretCallback_t *pFnInterpreter, lcsf_valid_cmd_t *pValidCmd, lcsf_repr_t repr) {
+    uint16_t genIdx = LcsfValidatorInfo.RxGenIdx;
+    lcsf_repr_t prevRepr = LcsfValidatorInfo.SendRepr;
+    LcsfValidatorInfo.IsInterpretingArray[genIdx] = true;
+    LcsfValidatorInfo.SendRepr = repr;
+    bool isInterpreted = pFnInterpreter(pValidCmd);
+    LcsfValidatorInfo.SendRepr = prevRepr;
+    LcsfValidatorInfo.IsInterpretingArray[genIdx] = false;
+    LCSF_ReleaseReceiverGen();
+    return isInterpreted;
 }
 
 /**
@@ -174,19 +408,32 @@ static bool LCSF_AllocateSenderAttArray(uint_fast16_t attNb, lcsf_raw_att_t **pA
 }
 
 /**
- * \fn static const lcsf_validator_protocol_desc_t *LCSF_GetProtEntry(uint_fast16_t protId)
+ * \fn static uint16_t LCSF_GetErrorProtocolId(lcsf_repr_t repr)
+ * \brief Retrieve the lcsf error protocol id of a representation
+ *
+ * \param repr message representation
+ * \return uint16_t: lcsf error protocol id
+ */
+static uint16_t LCSF_GetErrorProtocolId(lcsf_repr_t repr) {
+    return (repr == LCSF_REPR_SMALL) ? LCSF_ERROR_PROTOCOL_ID_SMALL : LCSF_ERROR_PROTOCOL_ID;
+}
+
+/**
+ * \fn static const lcsf_validator_protocol_desc_t *LCSF_GetProtEntry(const lcsf_registry_t *pRegistry, uint_fast16_t protId)
  * \brief Return the protocol validator entry matching an identifier
  *
  * The entry bundles the interpretor callback, protocol descriptor and version, so a single
  * look-up replaces separate scans for each field.
  *
+ * \param pRegistry pointer to the registry snapshot held by the reader
  * \param protId protocol identifier
  * \return lcsf_validator_protocol_desc_t *: Pointer to the entry (NULL if unknown protocol)
  */
-static const lcsf_validator_protocol_desc_t *LCSF_GetProtEntry(uint_fast16_t protId) {
+static const lcsf_validator_protocol_desc_t *LCSF_GetProtEntry(
+    const lcsf_registry_t *pRegistry, uint_fast16_t protId) {
     // Parse protocol array
     for (uint8_t idx = 0; idx < LcsfValidatorInfo.ProtNb; idx++) {
-        const lcsf_validator_protocol_desc_t *pProtocol = LcsfValidatorInfo.pProtArray[idx];
+        const lcsf_validator_protocol_desc_t *pProtocol = pRegistry->pProtArray[idx];
 
         if ((pProtocol != NULL) && (pProtocol->ProtId == protId)) {
             return pProtocol;
@@ -223,6 +470,237 @@ static lcsf_receive_status_t LCSF_MapValidationError(uint_fast8_t errType) {
     }
 }
 
+/**
+ * \fn static bool LCSF_IsCmdFiltered(const lcsf_registry_t *pRegistry, uint_fast16_t protId, uint_fast16_t cmdId)
+ * \brief Indicate if a command is filtered out by its protocol subscription bitmap
+ *
+ * \param pRegistry pointer to the registry snapshot held by the reader
+ * \param protId protocol identifier
+ * \param cmdId command identifier
+ * \return bool: true if the command is not subscribed
+ */
+static bool LCSF_IsCmdFiltered(const lcsf_registry_t *pRegistry, uint_fast16_t protId, uint_fast16_t cmdId) {
+    // Parse protocol array
+    for (uint8_t idx = 0; idx < LcsfValidatorInfo.ProtNb; idx++) {
+        const lcsf_validator_protocol_desc_t *pProtocol = pRegistry->pProtArray[idx];
+
+        if ((pProtocol != NULL) && (pProtocol->ProtId == protId)) {
+            const uint8_t *pBitmap = pRegistry->pCmdFilterArray[idx];
+            // No filter, all commands are subscribed
+            if (pBitmap == NULL) {
+                return false;
+            }
+            if (cmdId >= pRegistry->CmdFilterSizeArray[idx]) {
+                return true;
+            }
+            return (pBitmap[cmdId / 8] & (1 << (cmdId % 8))) == 0;
+        }
+    }
+    return false;
+}
+
+/**
+ * \fn static bool LCSF_IsProtTrusted(const lcsf_registry_t *pRegistry, uint_fast16_t protId)
+ * \brief Indicate if the messages of a protocol come from a trusted link
+ *
+ * \param pRegistry pointer to the registry snapshot held by the reader
+ * \param protId protocol identifier
+ * \return bool: true if the messages are first mapped by position
+ */
+static bool LCSF_IsProtTrusted(const lcsf_registry_t *pRegistry, uint_fast16_t protId) {
+    // Parse protocol array
+    for (uint8_t idx = 0; idx < LcsfValidatorInfo.ProtNb; idx++) {
+        const lcsf_validator_protocol_desc_t *pProtocol = pRegistry->pProtArray[idx];
+
+        if ((pProtocol != NULL) && (pProtocol->ProtId == protId)) {
+            return pRegistry->IsTrustedArray[idx];
+        }
+    }
+    return false;
+}
+
+/**
+ * \fn static LCSFInterpretCallback_t *LCSF_GetCmdHandler(const lcsf_validator_protocol_desc_t *pProt, uint_fast16_t cmdIdx)
+ * \brief Retrieve the function interpreting a command, its own handler if registered
+ *
+ * \param pProt pointer to the protocol entry
+ * \param cmdIdx index of the command in the protocol descriptor
+ * \return LCSFInterpretCallback_t *: pointer to the interpretation function
+ */
+static LCSFInterpretCallback_t *LCSF_GetCmdHandler(const lcsf_validator_protocol_desc_t *pProt, uint_fast16_t cmdIdx) {
+    if ((pProt->pFnCmdHandlerArray != NULL) && (pProt->pFnCmdHandlerArray[cmdIdx] != NULL)) {
+        return pProt->pFnCmdHandlerArray[cmdIdx];
+    }
+    return pProt->pFnInterpretMsg;
+}
+
+/**
+ * \fn static const lcsf_registry_t *LCSF_EnterRegistry(uint_fast8_t readerIdx)
+ * \brief Enter a registry read section, nested sections of a reader keep the snapshot of the outermost one
+ *
+ * \param readerIdx index of the reader (see _lcsf_registry_reader_enum)
+ * \return lcsf_registry_t *: pointer to the registry snapshot held until the section is left
+ */
+static const lcsf_registry_t *LCSF_EnterRegistry(uint_fast8_t readerIdx) {
+    lcsf_registry_reader_t *pReader = &(LcsfValidatorInfo.ReaderArray[readerIdx]);
+
+    if (pReader->Depth++ > 0) {
+        return pReader->pRegistry;
+    }
+    // Announce the reader before loading the published snapshot
+    LCSF_ATOMIC_FETCH_ADD(&pReader->ReadSeq, 1);
+    const lcsf_registry_t *pRegistry = LCSF_ATOMIC_LOAD(&LcsfValidatorInfo.pRegistry);
+    pReader->pRegistry = pRegistry;
+#if (LCSF_VALIDATOR_SHAPE_CACHE_NB > 0)
+    // Shapes point at the descriptors of a previous snapshot, they are only used by the receiver
+    if ((readerIdx == LCSF_READER_RX) && (LcsfValidatorInfo.ShapeGeneration != pRegistry->Generation)) {
+        memset(LcsfValidatorInfo.ShapeArray, 0, sizeof(LcsfValidatorInfo.ShapeArray));
+        LcsfValidatorInfo.NextShapeIdx = 0;
+        LcsfValidatorInfo.ShapeGeneration = pRegistry->Generation;
+    }
+#endif
+    return pRegistry;
+}
+
+/**
+ * \fn static void LCSF_LeaveRegistry(uint_fast8_t readerIdx)
+ * \brief Leave a registry read section, the outermost one releases its snapshot
+ *
+ * \param readerIdx index of the reader (see _lcsf_registry_reader_enum)
+ * \return void
+ */
+static void LCSF_LeaveRegistry(uint_fast8_t readerIdx) {
+    lcsf_registry_reader_t *pReader = &(LcsfValidatorInfo.ReaderArray[readerIdx]);
+
+    if (--pReader->Depth > 0) {
+        return;
+    }
+    pReader->pRegistry = NULL;
+    LCSF_ATOMIC_FETCH_ADD(&pReader->ReadSeq, 1);
+}
+
+/**
+ * \fn static lcsf_registry_t *LCSF_BeginRegistryUpdate(void)
+ * \brief Copy the published registry snapshot into the spare one to modify it
+ *
+ * \return lcsf_registry_t *: pointer to the spare snapshot, NULL if readers may still hold it
+ */
+static lcsf_registry_t *LCSF_BeginRegistryUpdate(void) {
+    if (!LCSF_ValidatorIsRegistrySynced()) {
+        return NULL;
+    }
+    lcsf_registry_t *pPublished = LCSF_ATOMIC_LOAD(&LcsfValidatorInfo.pRegistry);
+    lcsf_registry_t *pSpare = (pPublished == &(LcsfValidatorInfo.RegistryArray[0]))
+                                  ? &(LcsfValidatorInfo.RegistryArray[1])
+                                  : &(LcsfValidatorInfo.RegistryArray[0]);
+    memcpy(pSpare, pPublished, sizeof(lcsf_registry_t));
+    pSpare->Generation++;
+    return pSpare;
+}
+
+/**
+ * \fn static void LCSF_PublishRegistry(lcsf_registry_t *pRegistry)
+ * \brief Publish a registry snapshot, the previous one is released once the readers holding it are done
+ *
+ * \param pRegistry pointer to the snapshot to publish
+ * \return void
+ */
+static void LCSF_PublishRegistry(lcsf_registry_t *pRegistry) {
+    LCSF_ATOMIC_STORE(&LcsfValidatorInfo.pRegistry, pRegistry);
+    // A reader in its section at this point may hold the previous snapshot
+    for (uint8_t idx = 0; idx < LCSF_READER_NB; idx++) {
+        lcsf_registry_reader_t *pReader = &(LcsfValidatorInfo.ReaderArray[idx]);
+        pReader->PublishSeq = LCSF_ATOMIC_LOAD(&pReader->ReadSeq);
+    }
+}
+
+/**
+ * \fn static uint_fast8_t LCSF_GetFixedDataSize(uint_fast8_t descDataType)
+ * \brief Retrieve the data size of a fixed size data type
+ *
+ * \param descDataType data type from the descriptor
+ * \return uint_fast8_t: data size, 0 if the data type has no fixed size
+ */
+static uint_fast8_t LCSF_GetFixedDataSize(uint_fast8_t descDataType) {
+    switch (descDataType) {
+        case LCSF_UINT8:
+            return sizeof(uint8_t);
+        case LCSF_UINT16:
+            return sizeof(uint16_t);
+        case LCSF_UINT32:
+            return sizeof(uint32_t);
+        case LCSF_UINT64:
+            return sizeof(uint64_t);
+        case LCSF_FLOAT32:
+            return sizeof(float);
+        case LCSF_FLOAT64:
+            return sizeof(double);
+        default:
+            return 0;
+    }
+}
+
+/**
+ * \fn static void LCSF_AddFixedCommands(lcsf_registry_t *pRegistry, uint_fast16_t protIdx, const lcsf_protocol_desc_t *pProtDesc)
+ * \brief Note the fixed layout commands of a protocol, replacing the previous ones of its index
+ *
+ * \param pRegistry pointer to the registry snapshot to update
+ * \param protIdx index of the protocol
+ * \param pProtDesc pointer to the protocol descriptor
+ * \return void
+ */
+static void LCSF_AddFixedCommands(
+    lcsf_registry_t *pRegistry, uint_fast16_t protIdx, const lcsf_protocol_desc_t *pProtDesc) {
+    uint16_t fixedCmdNb = 0;
+    // Remove the previous protocol commands
+    for (uint16_t idx = 0; idx < pRegistry->FixedCmdNb; idx++) {
+        if (pRegistry->FixedCmdArray[idx].ProtIdx != protIdx) {
+            pRegistry->FixedCmdArray[fixedCmdNb++] = pRegistry->FixedCmdArray[idx];
+        }
+    }
+    pRegistry->FixedCmdNb = fixedCmdNb;
+    if ((pProtDesc == NULL) || (pProtDesc->pCmdDescArray == NULL)) {
+        return;
+    }
+    // Parse commands, other commands use the generic decoding
+    for (uint16_t cmdIdx = 0; cmdIdx < pProtDesc->CmdNb; cmdIdx++) {
+        const lcsf_command_desc_t *pCmdDesc = &(pProtDesc->pCmdDescArray[cmdIdx]);
+        uint16_t dataSize = 0;
+        bool isFixed = (pCmdDesc->AttNb > 0) && (pCmdDesc->pAttDescArray != NULL);
+        for (uint16_t attIdx = 0; isFixed && (attIdx < pCmdDesc->AttNb); attIdx++) {
+            const lcsf_attribute_desc_t *pAttDesc = &(pCmdDesc->pAttDescArray[attIdx]);
+            uint_fast8_t attDataSize = LCSF_GetFixedDataSize(pAttDesc->DataType);
+            // Attribute ids must fit in a single header byte in both representations
+            isFixed = !pAttDesc->IsOptional && (attDataSize > 0) && (pAttDesc->AttId <= 0x7F);
+            dataSize += attDataSize;
+        }
+        if (isFixed && (pRegistry->FixedCmdNb < LCSF_VALIDATOR_FIXED_CMD_NB)) {
+            lcsf_fixed_cmd_t *pFixedCmd = &(pRegistry->FixedCmdArray[pRegistry->FixedCmdNb++]);
+            pFixedCmd->pCmdDesc = pCmdDesc;
+            pFixedCmd->ProtIdx = protIdx;
+            pFixedCmd->DataSize = dataSize;
+        }
+    }
+}
+
+/**
+ * \fn static const lcsf_fixed_cmd_t *LCSF_FindFixedCmd(const lcsf_registry_t *pRegistry, const lcsf_command_desc_t *pCmdDesc)
+ * \brief Find the fixed layout entry of a command
+ *
+ * \param pRegistry pointer to the registry snapshot held by the reader
+ * \param pCmdDesc pointer to the command descriptor
+ * \return lcsf_fixed_cmd_t *: pointer to the entry, NULL if the command has no fixed layout
+ */
+static const lcsf_fixed_cmd_t *LCSF_FindFixedCmd(
+    const lcsf_registry_t *pRegistry, const lcsf_command_desc_t *pCmdDesc) {
+    for (uint16_t idx = 0; idx < pRegistry->FixedCmdNb; idx++) {
+        if (pRegistry->FixedCmdArray[idx].pCmdDesc == pCmdDesc) {
+            return &(pRegistry->FixedCmdArray[idx]);
+        }
+    }
+    return NULL;
+}
+
 /**
  * \fn static bool LCSF_ValidateCmdId(uint_fast16_t cmdId, uint_fast16_t cmdNb, uint16_t *pCmdIdx, const lcsf_command_desc_t *pCmdDescArray)
  * \brief Find the index in a command descriptor array corresponding to the identifier
@@ -250,21 +728,122 @@ static bool LCSF_ValidateCmdId(
 }
 
 /**
- * \fn static bool LCSF_HasNonOptionalAttribute(uint_fast16_t attNb, const lcsf_attribute_desc_t *pAttDescArray)
- * \brief Indicate if there is a non-optional attribute in a attribute descriptor array
+ * \fn static bool LCSF_ValidatePackedCmdId(uint_fast16_t cmdId, const lcsf_packed_prot_desc_t *pPackedDesc, uint16_t *pCmdIdx)
+ * \brief Find the index of a command in a packed protocol descriptor
  *
- * \param attNb number of attribute in the descriptor array
- * \param pAttDescArray pointer to the attribute descriptor array
+ * \param cmdId command identifier
+ * \param pPackedDesc pointer to the packed protocol descriptor
+ * \param pCmdIdx pointer to contain the command index
+ * \return bool: true if operation was a success
+ */
+static bool LCSF_ValidatePackedCmdId(
+    uint_fast16_t cmdId, const lcsf_packed_prot_desc_t *pPackedDesc, uint16_t *pCmdIdx) {
+    // Bad parameters guard
+    if ((pPackedDesc->pCmdArray == NULL) || (pPackedDesc->pAttArray == NULL)) {
+        return false;
+    }
+    // Parse command records
+    for (uint16_t idx = 0; idx < pPackedDesc->CmdNb; idx++) {
+        if (pPackedDesc->pCmdArray[idx].CmdId == cmdId) {
+            *pCmdIdx = idx;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * \fn static bool LCSF_ValidateProtCmdId(const lcsf_validator_protocol_desc_t *pProt, uint_fast16_t cmdId, uint16_t *pCmdIdx)
+ * \brief Find the index of a command in the descriptor of a protocol entry, packed or not
+ *
+ * \param pProt pointer to the protocol entry
+ * \param cmdId command identifier
+ * \param pCmdIdx pointer to contain the command index
+ * \return bool: true if operation was a success
+ */
+static bool LCSF_ValidateProtCmdId(
+    const lcsf_validator_protocol_desc_t *pProt, uint_fast16_t cmdId, uint16_t *pCmdIdx) {
+    if (pProt->pProtDesc != NULL) {
+        return LCSF_ValidateCmdId(cmdId, pProt->pProtDesc->CmdNb, pCmdIdx, pProt->pProtDesc->pCmdDescArray);
+    } else if (pProt->pPackedDesc != NULL) {
+        return LCSF_ValidatePackedCmdId(cmdId, pProt->pPackedDesc, pCmdIdx);
+    }
+    return false;
+}
+
+/**
+ * \fn static void LCSF_GetAttLevel(const lcsf_validator_protocol_desc_t *pProt, uint_fast16_t cmdIdx, lcsf_att_level_t *pLevel)
+ * \brief Retrieve the attribute level of a command, from either descriptor representation
+ *
+ * \param pProt pointer to the protocol entry
+ * \param cmdIdx index of the command in the protocol descriptor
+ * \param pLevel pointer to contain the attribute level
+ */
+static void LCSF_GetAttLevel(
+    const lcsf_validator_protocol_desc_t *pProt, uint_fast16_t cmdIdx, lcsf_att_level_t *pLevel) {
+    if (pProt->pProtDesc != NULL) {
+        const lcsf_command_desc_t *pCmdDesc = &(pProt->pProtDesc->pCmdDescArray[cmdIdx]);
+        pLevel->pAttDescArray = pCmdDesc->pAttDescArray;
+        pLevel->pPackedArray = NULL;
+        pLevel->AttIdx = 0;
+        pLevel->AttNb = pCmdDesc->AttNb;
+    } else {
+        const lcsf_packed_cmd_desc_t *pCmdDesc = &(pProt->pPackedDesc->pCmdArray[cmdIdx]);
+        pLevel->pAttDescArray = NULL;
+        pLevel->pPackedArray = pProt->pPackedDesc->pAttArray;
+        pLevel->AttIdx = pCmdDesc->AttIdx;
+        pLevel->AttNb = pCmdDesc->AttNb;
+    }
+}
+
+/**
+ * \fn static void LCSF_GetAttDesc(const lcsf_att_level_t *pLevel, uint_fast16_t idx, lcsf_att_info_t *pInfo)
+ * \brief Read the fields of an attribute descriptor of a level
+ *
+ * \param pLevel pointer to the attribute level
+ * \param idx index of the attribute in the level
+ * \param pInfo pointer to contain the attribute descriptor fields
+ */
+static void LCSF_GetAttDesc(const lcsf_att_level_t *pLevel, uint_fast16_t idx, lcsf_att_info_t *pInfo) {
+    if (pLevel->pPackedArray != NULL) {
+        // Sub-attribute records are referenced by index in the same array
+        const lcsf_packed_att_desc_t *pAttDesc = &(pLevel->pPackedArray[pLevel->AttIdx + idx]);
+        pInfo->AttId = LCSF_PACKED_ATT_ID(pAttDesc);
+        pInfo->DataType = pAttDesc->DataType;
+        pInfo->IsOptional = LCSF_PACKED_ATT_IS_OPT(pAttDesc);
+        pInfo->SubLevel.pAttDescArray = NULL;
+        pInfo->SubLevel.pPackedArray = pLevel->pPackedArray;
+        pInfo->SubLevel.AttIdx = pAttDesc->SubAttIdx;
+        pInfo->SubLevel.AttNb = pAttDesc->SubAttNb;
+    } else {
+        const lcsf_attribute_desc_t *pAttDesc = &(pLevel->pAttDescArray[idx]);
+        pInfo->AttId = pAttDesc->AttId;
+        pInfo->DataType = pAttDesc->DataType;
+        pInfo->IsOptional = pAttDesc->IsOptional;
+        pInfo->SubLevel.pAttDescArray = pAttDesc->pSubAttDescArray;
+        pInfo->SubLevel.pPackedArray = NULL;
+        pInfo->SubLevel.AttIdx = 0;
+        pInfo->SubLevel.AttNb = pAttDesc->SubAttNb;
+    }
+}
+
+/**
+ * \fn static bool LCSF_HasNonOptionalAttribute(const lcsf_att_level_t *pLevel)
+ * \brief Indicate if there is a non-optional attribute in an attribute level
+ *
+ * \param pLevel pointer to the attribute level
  * \return bool: true if there is a non-optional attribute
  */
-static bool LCSF_HasNonOptionalAttribute(uint_fast16_t attNb, const lcsf_attribute_desc_t *pAttDescArray) {
+static bool LCSF_HasNonOptionalAttribute(const lcsf_att_level_t *pLevel) {
     // Bad parameters guard
-    if (pAttDescArray == NULL) {
+    if ((pLevel->pAttDescArray == NULL) && (pLevel->pPackedArray == NULL)) {
         return false;
     }
+    lcsf_att_info_t attInfo;
     // Parse attributes
-    for (uint16_t idx = 0; idx < attNb; idx++) {
-        if (!pAttDescArray[idx].IsOptional) {
+    for (uint16_t idx = 0; idx < pLevel->AttNb; idx++) {
+        LCSF_GetAttDesc(pLevel, idx, &attInfo);
+        if (!attInfo.IsOptional) {
             return true;
         }
     }
@@ -320,6 +899,41 @@ static uint16_t LCSF_CountAttributes(uint_fast16_t descAttNb, lcsf_valid_att_t *
     return count;
 }
 
+/**
+ * \fn static bool LCSF_ValidateHeader(const lcsf_registry_t *pRegistry, const lcsf_raw_msg_t *pMessage,
+ *  const lcsf_validator_protocol_desc_t **pProtEntry, uint16_t *pCmdIdx)
+ * \brief Validate the protocol id, protocol version and command id of a received message
+ *
+ * \param pRegistry pointer to the registry snapshot held by the reader
+ * \param pMessage pointer to the message
+ * \param pProtEntry pointer to contain the protocol entry
+ * \param pCmdIdx pointer to contain the command index in the protocol descriptor
+ * \return bool: true if operation was a success, error type is noted in LastErrorType otherwise
+ */
+static bool LCSF_ValidateHeader(const lcsf_registry_t *pRegistry, const lcsf_raw_msg_t *pMessage,
+    const lcsf_validator_protocol_desc_t **pProtEntry, uint16_t *pCmdIdx) {
+    // Retrieve protocol entry (bundles callback, descriptor and version)
+    const lcsf_validator_protocol_desc_t *pProt = LCSF_GetProtEntry(pRegistry, pMessage->ProtId);
+    // Check if protocol id is valid
+    if ((pProt == NULL) || ((pProt->pProtDesc == NULL) && (pProt->pPackedDesc == NULL)) ||
+        (pProt->pFnInterpretMsg == NULL)) {
+        LcsfValidatorInfo.LastErrorType = LCSF_EP_ERROR_CODE_UNKNOWN_PROT_ID;
+        return false;
+    }
+    // Check if protocol version matches
+    if (pMessage->ProtVer != pProt->ProtVer) {
+        LcsfValidatorInfo.LastErrorType = LCSF_EP_ERROR_CODE_BAD_PROT_VER;
+        return false;
+    }
+    // Check if command id is valid
+    if (!LCSF_ValidateProtCmdId(pProt, pMessage->CmdId, pCmdIdx)) {
+        LcsfValidatorInfo.LastErrorType = LCSF_EP_ERROR_CODE_UNKNOWN_CMD_ID;
+        return false;
+    }
+    *pProtEntry = pProt;
+    return true;
+}
+
 /**
  * \fn static bool LCSF_ValidateDataType(size_t dataSize, uint_fast8_t descDataType)
  * \brief Validate the data size of received attribute payload
@@ -359,71 +973,101 @@ static bool LCSF_ValidateDataType(size_t dataSize, uint_fast8_t descDataType) {
 }
 
 /**
- * \fn static bool LCSF_ValidateAttribute_Rec(uint_fast16_t attNb, lcsf_raw_att_t *pAttArray, uint_fast16_t descAttNb, const lcsf_attribute_desc_t *pAttDescArray, lcsf_valid_att_t **pValidAttArray)
+ * \fn static uint_fast8_t LCSF_CountBits(uint32_t word)
+ * \brief Count the set bits of a word
+ *
+ * \param word word to process
+ * \return uint_fast8_t: number of set bits
+ */
+static uint_fast8_t LCSF_CountBits(uint32_t word) {
+    word = word - ((word >> 1) & 0x55555555);
+    word = (word & 0x33333333) + ((word >> 2) & 0x33333333);
+    word = (word + (word >> 4)) & 0x0F0F0F0F;
+    return (uint_fast8_t)((word * 0x01010101) >> 24);
+}
+
+/**
+ * \fn static bool LCSF_ValidateAttribute_Rec(uint_fast16_t attNb, const lcsf_raw_att_t *pAttArray, const lcsf_att_level_t *pLevel, bool isSparse, lcsf_valid_att_t **pValidAttArray)
  * \brief Recursively validate received attributes and their payload
  *
  * \param attNb number of attributes in the received array
  * \param pAttArray pointer to the received attribute array
- * \param descAttNb number of attributes in the descriptor array
- * \param pAttDescArray pointer to the attribute descriptor array
+ * \param pLevel pointer to the attribute descriptor level
+ * \param isSparse indicates if the validated arrays only hold the present attributes behind a presence bitmap
  * \param pValidAttArray pointer to contain the validated attributes array
  * \return bool: true if operation was a success
  */
-static bool LCSF_ValidateAttribute_Rec(uint_fast16_t attNb, const lcsf_raw_att_t *pAttArray, uint_fast16_t descAttNb,
-    const lcsf_attribute_desc_t *pAttDescArray, lcsf_valid_att_t **pValidAttArray) {
+static bool LCSF_ValidateAttribute_Rec(uint_fast16_t attNb, const lcsf_raw_att_t *pAttArray,
+    const lcsf_att_level_t *pLevel, bool isSparse, lcsf_valid_att_t **pValidAttArray) {
     // Bad parameters guard
-    if (pAttDescArray == NULL) {
+    if ((pLevel->pAttDescArray == NULL) && (pLevel->pPackedArray == NULL)) {
         LcsfValidatorInfo.LastErrorType = LCSF_EP_ERROR_CODE_UNKNOWN_ERROR;
         return false;
     }
     if (pAttArray == NULL) {
         // No attributes received, check if expected
-        if (LCSF_HasNonOptionalAttribute(descAttNb, pAttDescArray)) {
+        if (LCSF_HasNonOptionalAttribute(pLevel)) {
             LcsfValidatorInfo.LastErrorType = LCSF_EP_ERROR_CODE_MISS_NONOPT_ATT;
             return false;
         }
     }
+    uint_fast16_t descAttNb = pLevel->AttNb;
     if (attNb > descAttNb) {
         LcsfValidatorInfo.LastErrorType = LCSF_EP_ERROR_CODE_TOO_MANY_ATT;
         return false;
     }
-    // Allocate the valid attribute array
-    if (!LCSF_AllocateReceiverAttArray(descAttNb, pValidAttArray)) {
+    // Allocate the valid attribute array, a sparse array holds the presence word region then the received attributes
+    uint16_t wordNb = isSparse ? LCSF_SPARSE_WORD_NB(descAttNb) : 0;
+    uint16_t wordItemNb = isSparse ? (uint16_t)LCSF_SPARSE_ITEM_NB(descAttNb) : 0;
+    void *pRegion = NULL;
+    if (!LifoGet(LcsfValidatorInfo.pReceiverLifo, isSparse ? (wordItemNb + attNb) : descAttNb, &pRegion)) {
         LcsfValidatorInfo.LastErrorType = LCSF_EP_ERROR_CODE_UNKNOWN_ERROR;
         return false;
     }
+    *pValidAttArray = pRegion;
+    lcsf_sparse_word_t *pWordArray = pRegion;
+    for (uint16_t wordIdx = 0; wordIdx < wordNb; wordIdx++) {
+        pWordArray[wordIdx].Bitmap = 0;
+    }
+    lcsf_valid_att_t *pPresentAttArray = &((*pValidAttArray)[wordItemNb]);
     // Note the base number of received attributes
     uint16_t rxAttNb = attNb;
+    lcsf_att_info_t descAtt;
     // Parse through the descriptor list
     for (uint16_t idx = 0; idx < descAttNb; idx++) {
-        // Intermediary variables
-        lcsf_valid_att_t *pCurrValidAtt = &((*pValidAttArray)[idx]);
-        const lcsf_attribute_desc_t *pCurrDescAtt =
-            &(pAttDescArray[idx]); // Same index because both arrays should have same size
+        // Intermediary variables, present attributes are packed in a sparse array
+        uint16_t validIdx = isSparse ? (attNb - rxAttNb) : idx;
+        lcsf_valid_att_t *pCurrValidAtt = &(pPresentAttArray[validIdx]);
+        LCSF_GetAttDesc(pLevel, idx, &descAtt);
         uint16_t attIdx = 0;
         // Check if there is unprocessed received attributes and if one corresponds to current descriptor attribute
-        if ((rxAttNb > 0) && (LCSF_RecogniseAttributeId(pCurrDescAtt->AttId, attNb, &attIdx, pAttArray))) {
+        if ((rxAttNb > 0) && (LCSF_RecogniseAttributeId(descAtt.AttId, attNb, &attIdx, pAttArray))) {
             // Intermediary variable
             const lcsf_raw_att_t *pCurrRxAtt = &(pAttArray[attIdx]);
             // We take into account the processed attribute
             rxAttNb--;
+            if (isSparse) {
+                pWordArray[idx / 32].Bitmap |= (uint32_t)1 << (idx % 32);
+            }
             // Check the payload type
-            if (pCurrDescAtt->DataType == LCSF_SUB_ATTRIBUTES) {
+            if (descAtt.DataType == LCSF_SUB_ATTRIBUTES) {
                 if (pCurrRxAtt->HasSubAtt) {
                     // Process the sub-attributes
                     if (!LCSF_ValidateAttribute_Rec(pCurrRxAtt->PayloadSize, pCurrRxAtt->Payload.pSubAttArray,
-                            pCurrDescAtt->SubAttNb, pCurrDescAtt->pSubAttDescArray,
-                            &(pCurrValidAtt->Payload.pSubAttArray))) {
+                            &(descAtt.SubLevel), isSparse, &(pCurrValidAtt->Payload.pSubAttArray))) {
                         return false;
                     }
-                } else if (LCSF_HasNonOptionalAttribute(pCurrDescAtt->SubAttNb, pCurrDescAtt->pSubAttDescArray)) {
+                } else if (LCSF_HasNonOptionalAttribute(&(descAtt.SubLevel))) {
                     // Missing sub-attributes
                     LcsfValidatorInfo.LastErrorType = LCSF_EP_ERROR_CODE_MISS_NONOPT_ATT;
                     return false;
+                } else {
+                    // Empty sub-attribute array
+                    pCurrValidAtt->Payload.pSubAttArray = NULL;
                 }
             } else {
                 // Check if data type is valid
-                if (!LCSF_ValidateDataType(pCurrRxAtt->PayloadSize, pCurrDescAtt->DataType)) {
+                if (!LCSF_ValidateDataType(pCurrRxAtt->PayloadSize, descAtt.DataType)) {
                     LcsfValidatorInfo.LastErrorType = LCSF_EP_ERROR_CODE_WRONG_ATT_DATA_TYPE;
                     return false;
                 }
@@ -431,11 +1075,11 @@ static bool LCSF_ValidateAttribute_Rec(uint_fast16_t attNb, const lcsf_raw_att_t
                 pCurrValidAtt->Payload.pData = pCurrRxAtt->Payload.pData;
                 pCurrValidAtt->PayloadSize = pCurrRxAtt->PayloadSize;
             }
-        } else if (!pCurrDescAtt->IsOptional) {
+        } else if (!descAtt.IsOptional) {
             // Missing non-optional attribute, error
             LcsfValidatorInfo.LastErrorType = LCSF_EP_ERROR_CODE_MISS_NONOPT_ATT;
             return false;
-        } else {
+        } else if (!isSparse) {
             // Missing optional attribute, valid case
             pCurrValidAtt->Payload.pData = NULL;
         }
@@ -445,62 +1089,328 @@ static bool LCSF_ValidateAttribute_Rec(uint_fast16_t attNb, const lcsf_raw_att_t
         LcsfValidatorInfo.LastErrorType = LCSF_EP_ERROR_CODE_UNKNOWN_ATT_ID;
         return false;
     }
+    // Note the rank of each presence word
+    uint16_t rank = 0;
+    for (uint16_t wordIdx = 0; wordIdx < wordNb; wordIdx++) {
+        pWordArray[wordIdx].Rank = rank;
+        rank += LCSF_CountBits(pWordArray[wordIdx].Bitmap);
+    }
     return true;
 }
 
 /**
- * \fn static bool LCSF_ValidateAttribute(const lcsf_raw_msg_t *pMessage, const lcsf_command_desc_t *pCmdDesc, lcsf_valid_att_t **pValidAttArray)
+ * \fn static bool LCSF_ValidateAttribute(const lcsf_raw_msg_t *pMessage, const lcsf_validator_protocol_desc_t *pProt, uint_fast16_t cmdIdx, lcsf_valid_att_t **pValidAttArray)
  * \brief Validate the attributes of a received message
  *
  * \param pMessage pointer to the received message
- * \param pCmdDesc pointer to the command descriptor
+ * \param pProt pointer to the protocol entry
+ * \param cmdIdx index of the command in the protocol descriptor
  * \param pValidAttArray pointer to contain the validated attributes array
  * \return bool: true if operation was a success
  */
-static bool LCSF_ValidateAttribute(
-    const lcsf_raw_msg_t *pMessage, const lcsf_command_desc_t *pCmdDesc, lcsf_valid_att_t **pValidAttArray) {
-    if ((pCmdDesc->AttNb == 0) && (pMessage->AttNb > 0)) {
+static bool LCSF_ValidateAttribute(const lcsf_raw_msg_t *pMessage, const lcsf_validator_protocol_desc_t *pProt,
+    uint_fast16_t cmdIdx, lcsf_valid_att_t **pValidAttArray) {
+    lcsf_att_level_t cmdLevel;
+    LCSF_GetAttLevel(pProt, cmdIdx, &cmdLevel);
+
+    if ((cmdLevel.AttNb == 0) && (pMessage->AttNb > 0)) {
         // Attributes received while the descriptor expected none
         LcsfValidatorInfo.LastErrorType = LCSF_EP_ERROR_CODE_TOO_MANY_ATT;
         return false;
-    } else if ((pCmdDesc->AttNb != 0) && (pMessage->AttNb == 0)) {
+    } else if ((cmdLevel.AttNb != 0) && (pMessage->AttNb == 0)) {
         // No attributes received, check if missing attributes
-        if (LCSF_HasNonOptionalAttribute(pCmdDesc->AttNb, pCmdDesc->pAttDescArray)) {
+        if (LCSF_HasNonOptionalAttribute(&cmdLevel)) {
             LcsfValidatorInfo.LastErrorType = LCSF_EP_ERROR_CODE_MISS_NONOPT_ATT;
             return false;
         }
-    } else if ((pCmdDesc->AttNb != 0) && (pCmdDesc->pAttDescArray != NULL)) {
-        // Validate the attribute array
+    } else if ((cmdLevel.AttNb != 0) && ((cmdLevel.pAttDescArray != NULL) || (cmdLevel.pPackedArray != NULL))) {
+        // Validate the attribute array, shapes are memoized for dense arrays of pointer-based descriptors only
+#if (LCSF_VALIDATOR_SHAPE_CACHE_NB > 0)
+        if ((pProt->pProtDesc != NULL) && !pProt->IsSparse) {
+            return LCSF_ValidateCachedAttribute(pMessage, &(pProt->pProtDesc->pCmdDescArray[cmdIdx]), pValidAttArray);
+        }
+#endif
         return LCSF_ValidateAttribute_Rec(
-            pMessage->AttNb, pMessage->pAttArray, pCmdDesc->AttNb, pCmdDesc->pAttDescArray, pValidAttArray);
+            pMessage->AttNb, pMessage->pAttArray, &cmdLevel, pProt->IsSparse, pValidAttArray);
     }
     return true;
 }
 
 /**
- * \fn static bool LCSF_FillAttributeInfo(lcsf_raw_att_t *pRawAtt, uint_fast8_t descDataType, uint_fast16_t subAttNb, const lcsf_valid_att_t *pValidAtt)
- * \brief Fill a raw attribute info with data from a valid attribute and descriptor
+ * \fn static bool LCSF_MapTrustedAttribute_Rec(uint_fast16_t attNb, const lcsf_raw_att_t *pAttArray, uint_fast16_t descAttNb, const lcsf_attribute_desc_t *pAttDescArray, lcsf_valid_att_t **pValidAttArray)
+ * \brief Recursively map received attributes to their descriptor by position, assuming the descriptor order
  *
- * \param pRawAtt pointer to the raw attribute to fill
- * \param descDataType data type from the descriptor
- * \param subAttNb number of sub attribute
- * \param pValidAtt pointer to the valid attribute containing the info
- * \return bool: true if operation was a success
+ * Only the attribute id look ups are skipped, payload kinds and sizes are still checked.
+ *
+ * \param attNb number of attributes in the received array
+ * \param pAttArray pointer to the received attribute array
+ * \param descAttNb number of attributes in the descriptor array
+ * \param pAttDescArray pointer to the attribute descriptor array
+ * \param pValidAttArray pointer to contain the mapped attributes array
+ * \return bool: true if the attributes follow the descriptor order, false to use the full validation
  */
-static bool LCSF_FillAttributeInfo(
-    lcsf_raw_att_t *pRawAtt, uint_fast8_t descDataType, uint_fast16_t subAttNb, const lcsf_valid_att_t *pValidAtt) {
-    uint16_t stringSize = 0;
-
-    // Check data type
-    switch (descDataType) {
-        case LCSF_UINT8:
-            if (pValidAtt->PayloadSize != sizeof(uint8_t)) {
-                return false;
-            }
-            pRawAtt->PayloadSize = (uint16_t)pValidAtt->PayloadSize;
-            pRawAtt->HasSubAtt = false;
-            return true;
-
+static bool LCSF_MapTrustedAttribute_Rec(uint_fast16_t attNb, const lcsf_raw_att_t *pAttArray,
+    uint_fast16_t descAttNb, const lcsf_attribute_desc_t *pAttDescArray, lcsf_valid_att_t **pValidAttArray) {
+    // Bounds guard
+    if ((pAttArray == NULL) || (pAttDescArray == NULL) || (attNb > descAttNb)) {
+        return false;
+    }
+    if (!LCSF_AllocateReceiverAttArray(descAttNb, pValidAttArray)) {
+        return false;
+    }
+    uint16_t rxIdx = 0;
+    // Parse through the descriptor list, the next received attribute either matches or is absent
+    for (uint16_t idx = 0; idx < descAttNb; idx++) {
+        lcsf_valid_att_t *pCurrValidAtt = &((*pValidAttArray)[idx]);
+        const lcsf_attribute_desc_t *pCurrDescAtt = &(pAttDescArray[idx]);
+        if ((rxIdx >= attNb) || (pAttArray[rxIdx].AttId != pCurrDescAtt->AttId)) {
+            if (!pCurrDescAtt->IsOptional) {
+                return false;
+            }
+            pCurrValidAtt->Payload.pData = NULL;
+            continue;
+        }
+        const lcsf_raw_att_t *pCurrRxAtt = &(pAttArray[rxIdx++]);
+        // Payload kind must match to use the right union member
+        if (pCurrRxAtt->HasSubAtt != (pCurrDescAtt->DataType == LCSF_SUB_ATTRIBUTES)) {
+            return false;
+        }
+        if (pCurrRxAtt->HasSubAtt) {
+            if (!LCSF_MapTrustedAttribute_Rec(pCurrRxAtt->PayloadSize, pCurrRxAtt->Payload.pSubAttArray,
+                    pCurrDescAtt->SubAttNb, pCurrDescAtt->pSubAttDescArray, &(pCurrValidAtt->Payload.pSubAttArray))) {
+                return false;
+            }
+        } else {
+            // Bridges copy the data into fixed size fields
+            if (!LCSF_ValidateDataType(pCurrRxAtt->PayloadSize, pCurrDescAtt->DataType)) {
+                return false;
+            }
+            pCurrValidAtt->Payload.pData = pCurrRxAtt->Payload.pData;
+            pCurrValidAtt->PayloadSize = pCurrRxAtt->PayloadSize;
+        }
+    }
+    // Remaining attributes are out of order or unknown
+    return (rxIdx == attNb);
+}
+
+/**
+ * \fn static bool LCSF_MapTrustedAttribute(const lcsf_raw_msg_t *pMessage, const lcsf_command_desc_t *pCmdDesc, lcsf_valid_att_t **pValidAttArray)
+ * \brief Map the attributes of a message received from a trusted link
+ *
+ * \param pMessage pointer to the received message
+ * \param pCmdDesc pointer to the command descriptor
+ * \param pValidAttArray pointer to contain the mapped attributes array
+ * \return bool: true if the attributes were mapped, false to use the full validation
+ */
+static bool LCSF_MapTrustedAttribute(
+    const lcsf_raw_msg_t *pMessage, const lcsf_command_desc_t *pCmdDesc, lcsf_valid_att_t **pValidAttArray) {
+    if (pMessage->AttNb == 0) {
+        const lcsf_att_level_t cmdLevel = {pCmdDesc->pAttDescArray, NULL, 0, pCmdDesc->AttNb};
+        return !LCSF_HasNonOptionalAttribute(&cmdLevel);
+    }
+    return LCSF_MapTrustedAttribute_Rec(
+        pMessage->AttNb, pMessage->pAttArray, pCmdDesc->AttNb, pCmdDesc->pAttDescArray, pValidAttArray);
+}
+
+#if (LCSF_VALIDATOR_SHAPE_CACHE_NB > 0)
+/**
+ * \fn static bool LCSF_HashShape_Rec(uint_fast16_t attNb, const lcsf_raw_att_t *pAttArray, uint32_t *pHash, uint16_t *pAttNb)
+ * \brief Hash recursively the attribute ids, flags and sizes of a raw attribute array (FNV-1a)
+ *
+ * \param attNb number of attributes in the array
+ * \param pAttArray pointer to the raw attribute array
+ * \param pHash pointer to the hash
+ * \param pAttNb pointer to the number of attributes hashed
+ * \return bool: true if the shape fits in the cache
+ */
+static bool LCSF_HashShape_Rec(uint_fast16_t attNb, const lcsf_raw_att_t *pAttArray, uint32_t *pHash, uint16_t *pAttNb) {
+    if ((attNb > 0) && (pAttArray == NULL)) {
+        return false;
+    }
+    for (uint16_t idx = 0; idx < attNb; idx++) {
+        const lcsf_raw_att_t *pCurrAtt = &(pAttArray[idx]);
+        // Shape size guard
+        if (*pAttNb >= LCSF_VALIDATOR_SHAPE_ATT_NB) {
+            return false;
+        }
+        (*pAttNb)++;
+        *pHash = (*pHash ^ (pCurrAtt->AttId | ((uint32_t)pCurrAtt->HasSubAtt << 15))) * 16777619u;
+        *pHash = (*pHash ^ pCurrAtt->PayloadSize) * 16777619u;
+        if (pCurrAtt->HasSubAtt &&
+            !LCSF_HashShape_Rec(pCurrAtt->PayloadSize, pCurrAtt->Payload.pSubAttArray, pHash, pAttNb)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * \fn static bool LCSF_StoreShape_Rec(uint_fast16_t attNb, const lcsf_raw_att_t *pAttArray, uint_fast16_t descAttNb, const lcsf_attribute_desc_t *pAttDescArray, lcsf_shape_t *pShape)
+ * \brief Note recursively the shape of a validated raw attribute array and its descriptor indexes
+ *
+ * \param attNb number of attributes in the raw array
+ * \param pAttArray pointer to the raw attribute array
+ * \param descAttNb number of attributes in the descriptor array
+ * \param pAttDescArray pointer to the attribute descriptor array
+ * \param pShape pointer to the shape to fill
+ * \return bool: true if the shape can be memoized
+ */
+static bool LCSF_StoreShape_Rec(uint_fast16_t attNb, const lcsf_raw_att_t *pAttArray, uint_fast16_t descAttNb,
+    const lcsf_attribute_desc_t *pAttDescArray, lcsf_shape_t *pShape) {
+    for (uint16_t idx = 0; idx < attNb; idx++) {
+        const lcsf_raw_att_t *pCurrAtt = &(pAttArray[idx]);
+        uint16_t descIdx = 0;
+        // Find the matching descriptor
+        for (descIdx = 0; descIdx < descAttNb; descIdx++) {
+            if (pAttDescArray[descIdx].AttId == pCurrAtt->AttId) {
+                break;
+            }
+        }
+        if (descIdx >= descAttNb) {
+            return false;
+        }
+        const lcsf_attribute_desc_t *pCurrDescAtt = &(pAttDescArray[descIdx]);
+        // Only memoize attributes whose payload kind matches their descriptor
+        if (pCurrAtt->HasSubAtt != (pCurrDescAtt->DataType == LCSF_SUB_ATTRIBUTES)) {
+            return false;
+        }
+        lcsf_shape_att_t *pShapeAtt = &(pShape->AttArray[pShape->AttNb++]);
+        pShapeAtt->AttId = pCurrAtt->AttId;
+        pShapeAtt->HasSubAtt = pCurrAtt->HasSubAtt;
+        pShapeAtt->PayloadSize = pCurrAtt->PayloadSize;
+        pShapeAtt->DescIdx = descIdx;
+        if (pCurrAtt->HasSubAtt && !LCSF_StoreShape_Rec(pCurrAtt->PayloadSize, pCurrAtt->Payload.pSubAttArray,
+                                       pCurrDescAtt->SubAttNb, pCurrDescAtt->pSubAttDescArray, pShape)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * \fn static bool LCSF_ValidateShape_Rec(uint_fast16_t attNb, const lcsf_raw_att_t *pAttArray, uint_fast16_t descAttNb, const lcsf_attribute_desc_t *pAttDescArray, lcsf_valid_att_t **pValidAttArray, const lcsf_shape_t *pShape, uint16_t *pShapeIdx)
+ * \brief Fill recursively a valid attribute array from a memoized shape, without descriptor look ups
+ *
+ * \param attNb number of attributes in the raw array
+ * \param pAttArray pointer to the raw attribute array
+ * \param descAttNb number of attributes in the descriptor array
+ * \param pAttDescArray pointer to the attribute descriptor array
+ * \param pValidAttArray pointer to contain the valid attribute array
+ * \param pShape pointer to the memoized shape
+ * \param pShapeIdx pointer to the shape attribute index
+ * \return bool: true if the raw attributes match the shape
+ */
+static bool LCSF_ValidateShape_Rec(uint_fast16_t attNb, const lcsf_raw_att_t *pAttArray, uint_fast16_t descAttNb,
+    const lcsf_attribute_desc_t *pAttDescArray, lcsf_valid_att_t **pValidAttArray, const lcsf_shape_t *pShape,
+    uint16_t *pShapeIdx) {
+    // Allocate the valid attribute array, absent attributes stay cleared
+    if (!LCSF_AllocateReceiverAttArray(descAttNb, pValidAttArray)) {
+        return false;
+    }
+    for (uint16_t idx = 0; idx < descAttNb; idx++) {
+        (*pValidAttArray)[idx].Payload.pData = NULL;
+    }
+    for (uint16_t idx = 0; idx < attNb; idx++) {
+        const lcsf_raw_att_t *pCurrAtt = &(pAttArray[idx]);
+        const lcsf_shape_att_t *pShapeAtt = &(pShape->AttArray[(*pShapeIdx)++]);
+        // Hash collision guard
+        if ((pShapeAtt->AttId != pCurrAtt->AttId) || (pShapeAtt->HasSubAtt != pCurrAtt->HasSubAtt) ||
+            (pShapeAtt->PayloadSize != pCurrAtt->PayloadSize)) {
+            return false;
+        }
+        lcsf_valid_att_t *pCurrValidAtt = &((*pValidAttArray)[pShapeAtt->DescIdx]);
+        if (pCurrAtt->HasSubAtt) {
+            const lcsf_attribute_desc_t *pCurrDescAtt = &(pAttDescArray[pShapeAtt->DescIdx]);
+            if (!LCSF_ValidateShape_Rec(pCurrAtt->PayloadSize, pCurrAtt->Payload.pSubAttArray, pCurrDescAtt->SubAttNb,
+                    pCurrDescAtt->pSubAttDescArray, &(pCurrValidAtt->Payload.pSubAttArray), pShape, pShapeIdx)) {
+                return false;
+            }
+        } else {
+            pCurrValidAtt->Payload.pData = pCurrAtt->Payload.pData;
+            pCurrValidAtt->PayloadSize = pCurrAtt->PayloadSize;
+        }
+    }
+    return true;
+}
+
+/**
+ * \fn static bool LCSF_ValidateCachedAttribute(const lcsf_raw_msg_t *pMessage, const lcsf_command_desc_t *pCmdDesc, lcsf_valid_att_t **pValidAttArray)
+ * \brief Validate the attributes of a received message from a memoized shape, or memoize its shape once validated
+ *
+ * \param pMessage pointer to the received message
+ * \param pCmdDesc pointer to the command descriptor
+ * \param pValidAttArray pointer to contain the validated attributes array
+ * \return bool: true if operation was a success
+ */
+static bool LCSF_ValidateCachedAttribute(
+    const lcsf_raw_msg_t *pMessage, const lcsf_command_desc_t *pCmdDesc, lcsf_valid_att_t **pValidAttArray) {
+    uint32_t hash = 2166136261u;
+    uint16_t attNb = 0;
+    bool isCacheable = LCSF_HashShape_Rec(pMessage->AttNb, pMessage->pAttArray, &hash, &attNb);
+
+    if (isCacheable) {
+        // Look for a memoized shape
+        for (uint16_t idx = 0; idx < LCSF_VALIDATOR_SHAPE_CACHE_NB; idx++) {
+            const lcsf_shape_t *pShape = &(LcsfValidatorInfo.ShapeArray[idx]);
+            if ((pShape->pCmdDesc != pCmdDesc) || (pShape->Hash != hash) || (pShape->AttNb != attNb)) {
+                continue;
+            }
+            uint16_t shapeIdx = 0;
+            if (LCSF_ValidateShape_Rec(pMessage->AttNb, pMessage->pAttArray, pCmdDesc->AttNb, pCmdDesc->pAttDescArray,
+                    pValidAttArray, pShape, &shapeIdx)) {
+                LcsfValidatorInfo.ShapeStats.HitNb++;
+                return true;
+            }
+            // Hash collision, validate through the descriptor look ups
+            LifoFreeAll(LcsfValidatorInfo.pReceiverLifo);
+            break;
+        }
+    }
+    LcsfValidatorInfo.ShapeStats.MissNb++;
+    const lcsf_att_level_t cmdLevel = {pCmdDesc->pAttDescArray, NULL, 0, pCmdDesc->AttNb};
+    if (!LCSF_ValidateAttribute_Rec(pMessage->AttNb, pMessage->pAttArray, &cmdLevel, false, pValidAttArray)) {
+        return false;
+    }
+    if (isCacheable) {
+        // Memoize the shape, replacing the oldest one
+        lcsf_shape_t *pShape = &(LcsfValidatorInfo.ShapeArray[LcsfValidatorInfo.NextShapeIdx]);
+        pShape->pCmdDesc = NULL;
+        pShape->AttNb = 0;
+        if (LCSF_StoreShape_Rec(
+                pMessage->AttNb, pMessage->pAttArray, pCmdDesc->AttNb, pCmdDesc->pAttDescArray, pShape)) {
+            pShape->pCmdDesc = pCmdDesc;
+            pShape->Hash = hash;
+            LcsfValidatorInfo.NextShapeIdx = (LcsfValidatorInfo.NextShapeIdx + 1) % LCSF_VALIDATOR_SHAPE_CACHE_NB;
+        }
+    }
+    return true;
+}
+#endif
+
+/**
+ * \fn static bool LCSF_FillAttributeInfo(lcsf_raw_att_t *pRawAtt, uint_fast8_t descDataType, uint_fast16_t subAttNb, const lcsf_valid_att_t *pValidAtt)
+ * \brief Fill a raw attribute info with data from a valid attribute and descriptor
+ *
+ * \param pRawAtt pointer to the raw attribute to fill
+ * \param descDataType data type from the descriptor
+ * \param subAttNb number of sub attribute
+ * \param pValidAtt pointer to the valid attribute containing the info
+ * \return bool: true if operation was a success
+ */
+static bool LCSF_FillAttributeInfo(
+    lcsf_raw_att_t *pRawAtt, uint_fast8_t descDataType, uint_fast16_t subAttNb, const lcsf_valid_att_t *pValidAtt) {
+    uint16_t stringSize = 0;
+
+    // Check data type
+    switch (descDataType) {
+        case LCSF_UINT8:
+            if (pValidAtt->PayloadSize != sizeof(uint8_t)) {
+                return false;
+            }
+            pRawAtt->PayloadSize = (uint16_t)pValidAtt->PayloadSize;
+            pRawAtt->HasSubAtt = false;
+            return true;
+
         case LCSF_UINT16:
             if ((pValidAtt->PayloadSize == 0) || (pValidAtt->PayloadSize > sizeof(uint16_t))) {
                 return false;
@@ -569,47 +1479,46 @@ static bool LCSF_FillAttributeInfo(
 }
 
 /**
- * \fn static bool LCSF_FillAttribute_Rec(uint_fast16_t descAttNb, const lcsf_attribute_desc_t *pAttDescArray, const lcsf_valid_att_t *pValidAttArray, lcsf_raw_att_t *pRawAttArray)
- * \brief Fill recursively a raw attribute array with data from a valid and descriptor attribute array
- * \param descAttNb number of attributes in the descriptor array
- * \param pAttDescArray pointer to the attribute descriptor array
+ * \fn static bool LCSF_FillAttribute_Rec(const lcsf_att_level_t *pLevel, const lcsf_valid_att_t *pValidAttArray, lcsf_raw_att_t *pRawAttArray)
+ * \brief Fill recursively a raw attribute array with data from a valid attribute array and its descriptor level
+ * \param pLevel pointer to the attribute descriptor level
  * \param pValidAttArray pointer to the attribute array to send
  * \param pRawAttArray pointer to the raw attributes array to fill
  * \return bool: true if operation was a success
  */
-static bool LCSF_FillAttribute_Rec(uint_fast16_t descAttNb, const lcsf_attribute_desc_t *pAttDescArray,
-    const lcsf_valid_att_t *pValidAttArray, lcsf_raw_att_t *pRawAttArray) {
+static bool LCSF_FillAttribute_Rec(
+    const lcsf_att_level_t *pLevel, const lcsf_valid_att_t *pValidAttArray, lcsf_raw_att_t *pRawAttArray) {
     // Bad parameters guard
-    if ((pAttDescArray == NULL) || (pValidAttArray == NULL)) {
+    if (((pLevel->pAttDescArray == NULL) && (pLevel->pPackedArray == NULL)) || (pValidAttArray == NULL)) {
         return false;
     }
     // Raw attribute array index
     uint16_t fillIdx = 0;
+    lcsf_att_info_t attDesc;
     // Go through the valid attribute array
-    for (uint16_t idx = 0; idx < descAttNb; idx++) {
+    for (uint16_t idx = 0; idx < pLevel->AttNb; idx++) {
         // Intermediary variables
         const lcsf_valid_att_t *pCurrValidAtt = &(pValidAttArray[idx]);
-        const lcsf_attribute_desc_t *pCurrAttDesc =
-            &(pAttDescArray[idx]); // Same index because both arrays should have same size
         lcsf_raw_att_t *pCurrRawAtt = &(pRawAttArray[fillIdx]);
+        LCSF_GetAttDesc(pLevel, idx, &attDesc); // Same index because both arrays should have same size
         // Check if attribute is here or not
         if (pCurrValidAtt->Payload.pData == NULL) { // Same as (pCurrValidAtt->Payload.pSubAttArray == NULL) as it's an union
             // Check if attribute is optional
-            if (!pCurrAttDesc->IsOptional) {
+            if (!attDesc.IsOptional) {
                 return false;
             }
         } else { // Attribute is here
             uint16_t subAttNb = 0;
-            if (pCurrAttDesc->DataType == LCSF_SUB_ATTRIBUTES) {
+            if (attDesc.DataType == LCSF_SUB_ATTRIBUTES) {
                 // Count the sub-attributes
-                subAttNb = LCSF_CountAttributes(pCurrAttDesc->SubAttNb, pCurrValidAtt->Payload.pSubAttArray);
+                subAttNb = LCSF_CountAttributes(attDesc.SubLevel.AttNb, pCurrValidAtt->Payload.pSubAttArray);
             }
             // Fill attribute info
-            if (!LCSF_FillAttributeInfo(pCurrRawAtt, pCurrAttDesc->DataType, subAttNb, pCurrValidAtt)) {
+            if (!LCSF_FillAttributeInfo(pCurrRawAtt, attDesc.DataType, subAttNb, pCurrValidAtt)) {
                 return false;
             }
             // Note the attribute id
-            pCurrRawAtt->AttId = pCurrAttDesc->AttId;
+            pCurrRawAtt->AttId = attDesc.AttId;
             // Check if attribute has sub-attributes or data
             if (pCurrRawAtt->HasSubAtt) {
                 if (subAttNb == 0) {
@@ -620,8 +1529,8 @@ static bool LCSF_FillAttribute_Rec(uint_fast16_t descAttNb, const lcsf_attribute
                     return false;
                 }
                 // Fill sub-attribute array
-                if (!LCSF_FillAttribute_Rec(pCurrAttDesc->SubAttNb, pCurrAttDesc->pSubAttDescArray,
-                        pCurrValidAtt->Payload.pSubAttArray, pCurrRawAtt->Payload.pSubAttArray)) {
+                if (!LCSF_FillAttribute_Rec(
+                        &(attDesc.SubLevel), pCurrValidAtt->Payload.pSubAttArray, pCurrRawAtt->Payload.pSubAttArray)) {
                     return false;
                 }
             } else { // Attribute has data
@@ -636,46 +1545,152 @@ static bool LCSF_FillAttribute_Rec(uint_fast16_t descAttNb, const lcsf_attribute
 }
 
 /**
- * \fn static bool LCSF_FillAttributeArray(uint_fast16_t attNb, uint_fast16_t descAttNb, const lcsf_valid_att_t *pAttArray, const lcsf_command_desc_t *pCmdDesc, lcsf_raw_att_t **pRawAttArray)
- * \brief Fill a raw attribute array with data from a valid attribute array and a command descriptor
+ * \fn static bool LCSF_FillAttributeArray(uint_fast16_t attNb, const lcsf_valid_att_t *pAttArray, const lcsf_att_level_t *pLevel, lcsf_raw_att_t **pRawAttArray)
+ * \brief Fill a raw attribute array with data from a valid attribute array and a command attribute level
  *
  * \param attNb number of attributes of the command to send
  * \param pAttArray pointer to the attribute array to send
- * \param pCmdDesc pointer to the command descriptor
+ * \param pLevel pointer to the command attribute level
  * \param pRawAttArray pointer to contain the raw attributes array
  * \return bool: true if operation was a success
  */
 static bool LCSF_FillAttributeArray(uint_fast16_t attNb, const lcsf_valid_att_t *pAttArray,
-    const lcsf_command_desc_t *pCmdDesc, lcsf_raw_att_t **pRawAttArray) {
+    const lcsf_att_level_t *pLevel, lcsf_raw_att_t **pRawAttArray) {
     // Try to allocate the attribute list
     if (!LCSF_AllocateSenderAttArray(attNb, pRawAttArray)) {
         return false;
     }
     // Fill the attribute list
-    return LCSF_FillAttribute_Rec(pCmdDesc->AttNb, pCmdDesc->pAttDescArray, pAttArray, *pRawAttArray);
+    return LCSF_FillAttribute_Rec(pLevel, pAttArray, *pRawAttArray);
 }
 
 /**
- * \fn static bool LCSF_ValidatorSendError(uint_fast8_t errorLoc, uint_fast8_t errorType)
- * \brief Send an lcsf error message
+ * \fn static bool LCSF_FillSendMsg(const lcsf_registry_t *pRegistry, uint_fast16_t protId, const lcsf_valid_cmd_t *pCommand, lcsf_raw_msg_t *pSendMsg)
+ * \brief Validate a command and fill the raw message to encode, attributes are allocated in the sender lifo
  *
- * \param errorLoc location of the error encountered
- * \param errorType type of the error encountered
- * \return bool: true if operation successful
+ * \param pRegistry pointer to the registry snapshot held by the reader
+ * \param protId protocol identifier
+ * \param pCommand pointer to the command to send
+ * \param pSendMsg pointer to the raw message to fill
+ * \return bool: true if operation was a success
  */
-static bool LCSF_ValidatorSendError(uint_fast8_t errorLoc, uint_fast8_t errorType) {
-    // Check error send callback
-    if (LcsfValidatorInfo.pFnSendErrCb == NULL) {
-        LCSF_DBG_PRINT("[LCSF_Validator]: Sending error but missing callback\n");
+static bool LCSF_FillSendMsg(const lcsf_registry_t *pRegistry, uint_fast16_t protId, const lcsf_valid_cmd_t *pCommand,
+    lcsf_raw_msg_t *pSendMsg) {
+    // Retrieve protocol entry (bundles descriptor and version)
+    const lcsf_validator_protocol_desc_t *pProt = LCSF_GetProtEntry(pRegistry, protId);
+    if (pProt == NULL) {
+        // Unknown protocol
         return false;
     }
+    // Variables initialization
+    uint16_t cmdIdx = 0;
+    lcsf_att_level_t cmdLevel;
+    memset(pSendMsg, 0, sizeof(lcsf_raw_msg_t));
+    LifoFreeAll(&LcsfValidatorInfo.SenderLifo);
+    // Note the protocol id and version
+    pSendMsg->ProtId = protId;
+    pSendMsg->ProtVer = pProt->ProtVer;
+    // Validate command id
+    if (!LCSF_ValidateProtCmdId(pProt, pCommand->CmdId, &cmdIdx)) {
+        // Unknown command
+        return false;
+    }
+    LCSF_GetAttLevel(pProt, cmdIdx, &cmdLevel);
+    // Note the command id
+    pSendMsg->CmdId = pCommand->CmdId;
+    // Retrieve attribute number
+    pSendMsg->AttNb = LCSF_CountAttributes(cmdLevel.AttNb, pCommand->pAttArray);
+    // Validate attribute number
+    if (pSendMsg->AttNb == 0) {
+        // No attributes needed, the message is complete
+        return !LCSF_HasNonOptionalAttribute(&cmdLevel);
+    } else if (pSendMsg->AttNb > cmdLevel.AttNb) {
+        // Too many attributes
+        return false;
+    }
+    // Fill message attributes array
+    if (!LCSF_FillAttributeArray(pSendMsg->AttNb, pCommand->pAttArray, &cmdLevel, &(pSendMsg->pAttArray))) {
+        // Attribute error
+        LifoFreeAll(&LcsfValidatorInfo.SenderLifo);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * \fn static bool LCSF_PrepareAttribute_Rec(uint_fast16_t attNb, const lcsf_raw_att_t *pAttArray, size_t attHeaderSize, size_t *pBuffIdx, lcsf_prepared_cmd_t *pPrepared, size_t attArraySize)
+ * \brief Fill recursively the prepared attribute array following the encoded message order
+ *
+ * \param attNb number of attributes in the raw array
+ * \param pAttArray pointer to the raw attribute array
+ * \param attHeaderSize encoded attribute header size
+ * \param pBuffIdx pointer to the encoded message index
+ * \param pPrepared pointer to the prepared command
+ * \param attArraySize prepared attribute array size
+ * \return bool: true if operation was a success
+ */
+static bool LCSF_PrepareAttribute_Rec(uint_fast16_t attNb, const lcsf_raw_att_t *pAttArray, size_t attHeaderSize,
+    size_t *pBuffIdx, lcsf_prepared_cmd_t *pPrepared, size_t attArraySize) {
+    for (uint16_t idx = 0; idx < attNb; idx++) {
+        const lcsf_raw_att_t *pCurrAtt = &(pAttArray[idx]);
+        // Prepared array overflow guard
+        if (pPrepared->AttNb >= attArraySize) {
+            return false;
+        }
+        lcsf_prepared_att_t *pCurrPrepAtt = &(pPrepared->pAttArray[pPrepared->AttNb]);
+        pPrepared->AttNb++;
+        *pBuffIdx += attHeaderSize;
+        pCurrPrepAtt->AttId = pCurrAtt->AttId;
+        pCurrPrepAtt->HasSubAtt = pCurrAtt->HasSubAtt;
+        pCurrPrepAtt->PayloadSize = pCurrAtt->PayloadSize;
+        pCurrPrepAtt->Offset = (uint16_t)*pBuffIdx;
+        if (pCurrAtt->HasSubAtt) {
+            if (!LCSF_PrepareAttribute_Rec(pCurrAtt->PayloadSize, pCurrAtt->Payload.pSubAttArray, attHeaderSize,
+                    pBuffIdx, pPrepared, attArraySize)) {
+                return false;
+            }
+        } else {
+            *pBuffIdx += pCurrAtt->PayloadSize;
+            pPrepared->ValuesSize += pCurrAtt->PayloadSize;
+        }
+    }
+    return true;
+}
+
+/**
+ * \fn static void LCSF_PatchPreparedData(const lcsf_prepared_cmd_t *pPrepared, const uint8_t *pValues, uint8_t *pBuffer)
+ * \brief Write the attributes data of a prepared command at their offsets in an encoded message
+ *
+ * \param pPrepared pointer to the prepared command
+ * \param pValues pointer to the attributes data, following each other in the prepared attribute array order
+ * \param pBuffer pointer to the encoded message
+ */
+static void LCSF_PatchPreparedData(const lcsf_prepared_cmd_t *pPrepared, const uint8_t *pValues, uint8_t *pBuffer) {
+    size_t valuesIdx = 0;
+    for (uint16_t idx = 0; idx < pPrepared->AttNb; idx++) {
+        const lcsf_prepared_att_t *pCurrPrepAtt = &(pPrepared->pAttArray[idx]);
+        if (!pCurrPrepAtt->HasSubAtt) {
+            memcpy(&(pBuffer[pCurrPrepAtt->Offset]), &(pValues[valuesIdx]), pCurrPrepAtt->PayloadSize);
+            valuesIdx += pCurrPrepAtt->PayloadSize;
+        }
+    }
+}
+
+/**
+ * \fn static bool LCSF_EncodeErrorTemplate(lcsf_repr_t repr, uint8_t *pValues)
+ * \brief Encode the lcsf error message template of a representation, its data is patched by the next errors
+ *
+ * \param repr message representation
+ * \param pValues pointer to the error location and type values
+ * \return bool: true if operation was a success
+ */
+static bool LCSF_EncodeErrorTemplate(lcsf_repr_t repr, uint8_t *pValues) {
+    lcsf_err_template_t *pTemplate = &(LcsfValidatorInfo.ErrTemplateArray[repr]);
     lcsf_raw_msg_t errorMsg;
     lcsf_raw_att_t msgAttArray[LCSF_EP_CMD_ERROR_ATT_NB];
-    uint8_t errorLocVal = errorLoc;
-    uint8_t errorTypeVal = errorType;
     // Fill message information
     errorMsg.ProtVer = LCSF_ERROR_PROTOCOL_VERSION;
-    errorMsg.ProtId = LCSF_ERROR_PROTOCOL_ID;
+    errorMsg.ProtId = LCSF_GetErrorProtocolId(repr);
     errorMsg.CmdId = LCSF_EP_CMD_ERROR_ID;
     errorMsg.AttNb = LCSF_EP_CMD_ERROR_ATT_NB;
     errorMsg.pAttArray = msgAttArray;
@@ -683,21 +1698,59 @@ static bool LCSF_ValidatorSendError(uint_fast8_t errorLoc, uint_fast8_t errorTyp
     msgAttArray[0].AttId = LCSF_EP_CMD_ERROR_ATT_ERR_LOC_ID;
     msgAttArray[0].PayloadSize = LCSF_EP_CMD_ERROR_ATT_ERR_LOC_SIZE;
     msgAttArray[0].HasSubAtt = false;
-    msgAttArray[0].Payload.pData = &errorLocVal;
+    msgAttArray[0].Payload.pData = &(pValues[0]);
     // Fill error code attribute
     msgAttArray[1].AttId = LCSF_EP_CMD_ERROR_ATT_ERR_TYPE_ID;
     msgAttArray[1].PayloadSize = LCSF_EP_CMD_ERROR_ATT_ERR_TYPE_SIZE;
     msgAttArray[1].HasSubAtt = false;
-    msgAttArray[1].Payload.pData = &errorTypeVal;
+    msgAttArray[1].Payload.pData = &(pValues[1]);
     // Encode the message with transcoder
-    int msgSize = LCSF_TranscoderEncode(&errorMsg, LcsfValidatorInfo.Err_buff, ERR_BUFF_SIZE);
+    int msgSize = LCSF_TranscoderEncodeRepr(&errorMsg, pTemplate->Buffer, ERR_BUFF_SIZE, repr);
     if (msgSize < 0) {
         LCSF_DBG_PRINT("[LCSF_Validator]: Encoding lcsf error messages failed.\n");
         return false;
     }
+    // Note the data layout from the raw message
+    bool isSmall = (repr == LCSF_REPR_SMALL);
+    size_t buffIdx = isSmall ? 4 : 8;
+    pTemplate->Prepared.pBuffer = pTemplate->Buffer;
+    pTemplate->Prepared.MsgSize = (uint16_t)msgSize;
+    pTemplate->Prepared.ValuesSize = 0;
+    pTemplate->Prepared.AttNb = 0;
+    pTemplate->Prepared.pAttArray = pTemplate->AttArray;
+    pTemplate->IsEncoded = LCSF_PrepareAttribute_Rec(LCSF_EP_CMD_ERROR_ATT_NB, msgAttArray, isSmall ? 2 : 4,
+        &buffIdx, &(pTemplate->Prepared), LCSF_EP_CMD_ERROR_ATT_NB);
+    return pTemplate->IsEncoded;
+}
+
+/**
+ * \fn static bool LCSF_ValidatorSendError(uint_fast8_t errorLoc, uint_fast8_t errorType, lcsf_repr_t repr)
+ * \brief Send an lcsf error message
+ *
+ * \param errorLoc location of the error encountered
+ * \param errorType type of the error encountered
+ * \param repr representation of the error message
+ * \return bool: true if operation successful
+ */
+static bool LCSF_ValidatorSendError(uint_fast8_t errorLoc, uint_fast8_t errorType, lcsf_repr_t repr) {
+    // Check error send callback
+    if (LcsfValidatorInfo.pFnSendErrCb == NULL) {
+        LCSF_DBG_PRINT("[LCSF_Validator]: Sending error but missing callback\n");
+        return false;
+    }
+    uint8_t values[LCSF_EP_CMD_ERROR_ATT_NB] = {(uint8_t)errorLoc, (uint8_t)errorType};
+    uint8_t errBuffer[ERR_BUFF_SIZE];
+    // The first error sent in the representation encodes its template
+    lcsf_err_template_t *pTemplate = &(LcsfValidatorInfo.ErrTemplateArray[repr]);
+    if (!pTemplate->IsEncoded && !LCSF_EncodeErrorTemplate(repr, values)) {
+        return false;
+    }
+    // Patch the error values in a copy of the template, the callback may send another error
+    memcpy(errBuffer, pTemplate->Buffer, pTemplate->Prepared.MsgSize);
+    LCSF_PatchPreparedData(&(pTemplate->Prepared), values, errBuffer);
     // Send error message
     LCSF_DBG_PRINT("[LCSF_Validator]: Sending error, location: %d, type: %d\n", errorLoc, errorType);
-    if (!LcsfValidatorInfo.pFnSendErrCb(LcsfValidatorInfo.Err_buff, msgSize)) {
+    if (!LcsfValidatorInfo.pFnSendErrCb(errBuffer, pTemplate->Prepared.MsgSize)) {
         LCSF_DBG_PRINT("[LCSF_Validator]: Send lcsf error message failed!\n");
         return false;
     }
@@ -740,14 +1793,301 @@ static bool LCSF_ProcessReceivedError(const lcsf_raw_msg_t *pErrorMsg) {
 }
 
 /**
- * \fn bool LCSF_ValidatorSendTranscoderError(uint_fast8_t errorType)
+ * \fn bool LCSF_ValidatorSendTranscoderError(uint_fast8_t errorType, lcsf_repr_t repr)
  * \brief Send an LCSF transcoder error message, should only be used by LCSF_Transcoder.
  *
  * \param errorType error code to send
+ * \param repr representation of the message that failed to decode
  * \return bool: true if operation successful
  */
-bool LCSF_ValidatorSendTranscoderError(uint_fast8_t errorType) {
-    return LCSF_ValidatorSendError(LCSF_EP_ERROR_LOC_DECODE_ERROR, errorType);
+bool LCSF_ValidatorSendTranscoderError(uint_fast8_t errorType, lcsf_repr_t repr) {
+    return LCSF_ValidatorSendError(LCSF_EP_ERROR_LOC_DECODE_ERROR, errorType, repr);
+}
+
+/**
+ * \fn static bool LCSF_PackAttDesc_Rec(uint_fast16_t attNb, const lcsf_attribute_desc_t *pAttDescArray, uint_fast16_t levelIdx, lcsf_packed_att_desc_t *pAttArray, size_t attArraySize, size_t *pNextIdx)
+ * \brief Convert recursively an attribute descriptor level into contiguous packed records
+ *
+ * \param attNb number of attributes in the descriptor array
+ * \param pAttDescArray pointer to the attribute descriptor array
+ * \param levelIdx index of the level first record (already reserved)
+ * \param pAttArray pointer to the attribute record array
+ * \param attArraySize number of records the array can hold
+ * \param pNextIdx pointer to the index of the next free record
+ * \return bool: true if operation was a success
+ */
+static bool LCSF_PackAttDesc_Rec(uint_fast16_t attNb, const lcsf_attribute_desc_t *pAttDescArray,
+    uint_fast16_t levelIdx, lcsf_packed_att_desc_t *pAttArray, size_t attArraySize, size_t *pNextIdx) {
+    // Bad parameters guard
+    if ((attNb > 0) && (pAttDescArray == NULL)) {
+        return false;
+    }
+    for (uint16_t idx = 0; idx < attNb; idx++) {
+        const lcsf_attribute_desc_t *pAttDesc = &(pAttDescArray[idx]);
+        lcsf_packed_att_desc_t *pRecord = &(pAttArray[levelIdx + idx]);
+        // Record field limits guard
+        if ((pAttDesc->AttId > LCSF_PACKED_ATT_ID_MASK) || (pAttDesc->SubAttNb > 0xFF)) {
+            return false;
+        }
+        pRecord->AttIdOpt = LCSF_PACKED_ATT_ID_OPT(pAttDesc->AttId, pAttDesc->IsOptional);
+        pRecord->DataType = (uint8_t)pAttDesc->DataType;
+        pRecord->SubAttNb = 0;
+        pRecord->SubAttIdx = 0;
+        if ((pAttDesc->DataType == LCSF_SUB_ATTRIBUTES) && (pAttDesc->SubAttNb > 0)) {
+            // Reserve the sub-attribute level after the records in use
+            size_t subAttIdx = *pNextIdx;
+            if (((subAttIdx + pAttDesc->SubAttNb) > attArraySize) || (subAttIdx > 0xFFFF)) {
+                return false;
+            }
+            *pNextIdx += pAttDesc->SubAttNb;
+            pRecord->SubAttNb = (uint8_t)pAttDesc->SubAttNb;
+            pRecord->SubAttIdx = (uint16_t)subAttIdx;
+            if (!LCSF_PackAttDesc_Rec(pAttDesc->SubAttNb, pAttDesc->pSubAttDescArray, (uint16_t)subAttIdx, pAttArray,
+                    attArraySize, pNextIdx)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * \fn static uint32_t LCSF_GetAttDescUsage_Rec(uint_fast16_t attNb, const lcsf_attribute_desc_t *pAttDescArray,
+ *  uint_fast16_t depth, uint16_t *pMaxDepth)
+ * \brief Recursively count the items needed to hold an attribute array and its sub-attributes
+ *
+ * \param attNb number of attributes in the array
+ * \param pAttDescArray pointer to the attribute descriptor array
+ * \param depth nesting depth of the array
+ * \param pMaxDepth pointer to contain the maximum nesting depth
+ * \return uint32_t: number of items
+ */
+static uint32_t LCSF_GetAttDescUsage_Rec(
+    uint_fast16_t attNb, const lcsf_attribute_desc_t *pAttDescArray, uint_fast16_t depth, uint16_t *pMaxDepth) {
+    // No attributes guard
+    if ((attNb == 0) || (pAttDescArray == NULL)) {
+        return 0;
+    }
+    uint32_t itemNb = attNb;
+    // Note depth
+    if (depth > *pMaxDepth) {
+        *pMaxDepth = depth;
+    }
+    // Parse attributes
+    for (uint16_t idx = 0; idx < attNb; idx++) {
+        const lcsf_attribute_desc_t *pAttDesc = &(pAttDescArray[idx]);
+        if (pAttDesc->DataType == LCSF_SUB_ATTRIBUTES) {
+            itemNb += LCSF_GetAttDescUsage_Rec(pAttDesc->SubAttNb, pAttDesc->pSubAttDescArray, depth + 1, pMaxDepth);
+        }
+    }
+    return itemNb;
+}
+
+/**
+ * \fn static lcsf_receive_status_t LCSF_ReadCheckHeader(const lcsf_registry_t *pRegistry, const lcsf_raw_msg_t *pMessage, lcsf_repr_t repr)
+ * \brief Check a message header in a registry read section
+ *
+ * \param pRegistry pointer to the registry snapshot held by the reader
+ * \param pMessage pointer to the message, only its header is used
+ * \param repr message representation
+ * \return lcsf_receive_status_t: LCSF_RECEIVE_OK if the message can be decoded, otherwise the matching error status
+ */
+static lcsf_receive_status_t LCSF_ReadCheckHeader(
+    const lcsf_registry_t *pRegistry, const lcsf_raw_msg_t *pMessage, lcsf_repr_t repr) {
+    // Bad parameters guard
+    if (pMessage == NULL) {
+        return LCSF_RECEIVE_ERROR;
+    }
+    // Lcsf error messages are checked once decoded
+    if (pMessage->ProtId == LCSF_GetErrorProtocolId(repr)) {
+        return LCSF_RECEIVE_OK;
+    }
+    // Silently drop unsubscribed commands
+    if (LCSF_IsCmdFiltered(pRegistry, pMessage->ProtId, pMessage->CmdId)) {
+        return LCSF_RECEIVE_FILTERED;
+    }
+    const lcsf_validator_protocol_desc_t *pProt = NULL;
+    uint16_t descCmdIdx = 0;
+    // Check protocol id, version and command id
+    if (!LCSF_ValidateHeader(pRegistry, pMessage, &pProt, &descCmdIdx)) {
+        LCSF_ValidatorSendError(LCSF_EP_ERROR_LOC_VALIDATION_ERROR, LcsfValidatorInfo.LastErrorType, repr);
+        return LCSF_MapValidationError(LcsfValidatorInfo.LastErrorType);
+    }
+    return LCSF_RECEIVE_OK;
+}
+
+/**
+ * \fn lcsf_receive_status_t LCSF_ValidatorCheckHeader(const lcsf_raw_msg_t *pMessage, lcsf_repr_t repr)
+ * \brief Check a message header before its attributes are decoded, should only be used by LCSF_Transcoder.
+ *
+ * Sends the matching validation error if the message is rejected.
+ *
+ * \param pMessage pointer to the message, only its header is used
+ * \param repr message representation
+ * \return lcsf_receive_status_t: LCSF_RECEIVE_OK if the message can be decoded, otherwise the matching error status
+ */
+lcsf_receive_status_t LCSF_ValidatorCheckHeader(const lcsf_raw_msg_t *pMessage, lcsf_repr_t repr) {
+    const lcsf_registry_t *pRegistry = LCSF_EnterRegistry(LCSF_READER_RX);
+    lcsf_receive_status_t status = LCSF_ReadCheckHeader(pRegistry, pMessage, repr);
+    LCSF_LeaveRegistry(LCSF_READER_RX);
+    return status;
+}
+
+/**
+ * \fn static bool LCSF_ReadReceiveFixed(const lcsf_registry_t *pRegistry, const lcsf_raw_msg_t *pMessage, const uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr, lcsf_receive_status_t *pStatus)
+ * \brief Receive a fixed layout command in a registry read section
+ *
+ * \param pRegistry pointer to the registry snapshot held by the reader
+ * \param pMessage pointer to the message, only its header is used
+ * \param pBuffer pointer to the encoded attributes, following the message header
+ * \param buffSize size of the encoded attributes
+ * \param repr message representation
+ * \param pStatus pointer to contain the receive status if the message was processed
+ * \return bool: true if the message matched a fixed layout and was processed
+ */
+static bool LCSF_ReadReceiveFixed(const lcsf_registry_t *pRegistry, const lcsf_raw_msg_t *pMessage,
+    const uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr, lcsf_receive_status_t *pStatus) {
+    // Bad parameters guard
+    if ((pMessage == NULL) || (pBuffer == NULL) || (pStatus == NULL) || (pRegistry->FixedCmdNb == 0)) {
+        return false;
+    }
+    // Retrieve the command fixed layout
+    const lcsf_validator_protocol_desc_t *pProt = LCSF_GetProtEntry(pRegistry, pMessage->ProtId);
+    if ((pProt == NULL) || (pProt->pProtDesc == NULL) || pProt->IsSparse) {
+        return false;
+    }
+    uint16_t descCmdIdx = 0;
+    if (!LCSF_ValidateCmdId(
+            pMessage->CmdId, pProt->pProtDesc->CmdNb, &descCmdIdx, pProt->pProtDesc->pCmdDescArray)) {
+        return false;
+    }
+    const lcsf_command_desc_t *pCmdDesc = &(pProt->pProtDesc->pCmdDescArray[descCmdIdx]);
+    const lcsf_fixed_cmd_t *pFixedCmd = LCSF_FindFixedCmd(pRegistry, pCmdDesc);
+    if (pFixedCmd == NULL) {
+        return false;
+    }
+    bool isSmall = (repr == LCSF_REPR_SMALL);
+    size_t attHeaderSize = isSmall ? 2 : 4;
+    // Attribute number and total size guard
+    size_t fixedSize = (pCmdDesc->AttNb * attHeaderSize) + pFixedCmd->DataSize;
+    if ((pMessage->AttNb != pCmdDesc->AttNb) || (buffSize != fixedSize)) {
+        return false;
+    }
+    lcsf_valid_cmd_t validMsg;
+    if (!LCSF_SelectReceiverGen()) {
+        return false;
+    }
+    if (!LCSF_AllocateReceiverAttArray(pCmdDesc->AttNb, &(validMsg.pAttArray))) {
+        return false;
+    }
+    validMsg.CmdId = pMessage->CmdId;
+    // Check the attribute headers and point at the data in place
+    size_t buffIdx = 0;
+    for (uint16_t idx = 0; idx < pCmdDesc->AttNb; idx++) {
+        const lcsf_attribute_desc_t *pAttDesc = &(pCmdDesc->pAttDescArray[idx]);
+        const uint8_t *pHeader = &(pBuffer[buffIdx]);
+        uint_fast8_t dataSize = LCSF_GetFixedDataSize(pAttDesc->DataType);
+        bool isMatching;
+        if (isSmall) {
+            isMatching = (pHeader[0] == pAttDesc->AttId) && (pHeader[1] == dataSize);
+        } else {
+            isMatching = (pHeader[0] == pAttDesc->AttId) && (pHeader[1] == 0) && (pHeader[2] == dataSize) &&
+                         (pHeader[3] == 0);
+        }
+        if (!isMatching) {
+            // Left to the generic decoding
+            LifoFreeAll(LcsfValidatorInfo.pReceiverLifo);
+            return false;
+        }
+        buffIdx += attHeaderSize;
+        validMsg.pAttArray[idx].PayloadSize = dataSize;
+        validMsg.pAttArray[idx].Payload.pData = (void *)&(pBuffer[buffIdx]);
+        buffIdx += dataSize;
+    }
+    // Send validated message to interpreter function
+    bool isInterpreted = LCSF_InterpretCmd(LCSF_GetCmdHandler(pProt, descCmdIdx), &validMsg, repr);
+    *pStatus = isInterpreted ? LCSF_RECEIVE_OK : LCSF_RECEIVE_ERROR;
+    return true;
+}
+
+/**
+ * \fn bool LCSF_ValidatorReceiveFixed(const lcsf_raw_msg_t *pMessage, const uint8_t *pBuffer, size_t buffSize, lcsf_repr_t repr, lcsf_receive_status_t *pStatus)
+ * \brief Receive a fixed layout command straight from its attributes buffer, should only be used by LCSF_Transcoder.
+ *
+ * The header must have been checked by LCSF_ValidatorCheckHeader. The attributes must follow the descriptor order
+ * with their exact data size, otherwise the message is left to the generic decoding.
+ *
+ * \param pMessage pointer to the message, only its header is used
+ * \param pBuffer pointer to the encoded attributes, following the message header
+ * \param buffSize size of the encoded attributes
+ * \param repr message representation
+ * \param pStatus pointer to contain the receive status if the message was processed
+ * \return bool: true if the message matched a fixed layout and was processed
+ */
+bool LCSF_ValidatorReceiveFixed(const lcsf_raw_msg_t *pMessage, const uint8_t *pBuffer, size_t buffSize,
+    lcsf_repr_t repr, lcsf_receive_status_t *pStatus) {
+    // Receives nest from interpretation functions
+    uint16_t prevGenIdx = LcsfValidatorInfo.RxGenIdx;
+    const lcsf_registry_t *pRegistry = LCSF_EnterRegistry(LCSF_READER_RX);
+    bool isProcessed = LCSF_ReadReceiveFixed(pRegistry, pMessage, pBuffer, buffSize, repr, pStatus);
+    LCSF_LeaveRegistry(LCSF_READER_RX);
+    LCSF_RestoreReceiverGen(prevGenIdx);
+    return isProcessed;
+}
+
+/**
+ * \fn static lcsf_receive_status_t LCSF_ReadReceive(const lcsf_registry_t *pRegistry, const lcsf_raw_msg_t *pMessage, lcsf_repr_t repr)
+ * \brief Receive a message in a registry read section
+ *
+ * \param pRegistry pointer to the registry snapshot held by the reader
+ * \param pMessage pointer to the message to receive
+ * \param repr representation the message was received in
+ * \return lcsf_receive_status_t: LCSF_RECEIVE_OK if the message was interpreted, otherwise the matching error status
+ */
+static lcsf_receive_status_t LCSF_ReadReceive(
+    const lcsf_registry_t *pRegistry, const lcsf_raw_msg_t *pMessage, lcsf_repr_t repr) {
+    // Bad parameters guard
+    if (pMessage == NULL) {
+        return LCSF_RECEIVE_ERROR;
+    }
+    // Process lcsf error messages
+    if (pMessage->ProtId == LCSF_GetErrorProtocolId(repr)) {
+        return LCSF_ProcessReceivedError(pMessage) ? LCSF_RECEIVE_OK : LCSF_RECEIVE_ERROR;
+    }
+    // Variables initialization
+    const lcsf_validator_protocol_desc_t *pProt = NULL;
+    uint16_t descCmdIdx = 0;
+    lcsf_valid_cmd_t validMsg;
+    // Check protocol id, version and command id
+    if (!LCSF_ValidateHeader(pRegistry, pMessage, &pProt, &descCmdIdx)) {
+        LCSF_ValidatorSendError(LCSF_EP_ERROR_LOC_VALIDATION_ERROR, LcsfValidatorInfo.LastErrorType, repr);
+        return LCSF_MapValidationError(LcsfValidatorInfo.LastErrorType);
+    }
+    const lcsf_protocol_desc_t *pProtDesc = pProt->pProtDesc;
+    LCSFInterpretCallback_t *pFnInterpreter = LCSF_GetCmdHandler(pProt, descCmdIdx);
+    // All the generations hold a command, the message is dropped
+    if (!LCSF_SelectReceiverGen()) {
+        return LCSF_RECEIVE_ERROR;
+    }
+    memset(&validMsg, 0, sizeof(lcsf_valid_cmd_t));
+    // Validate the command id
+    validMsg.CmdId = pMessage->CmdId;
+    // Trusted links are mapped by position first, the full validation takes over at the first mismatch
+    bool isValid = (pProtDesc != NULL) && !pProt->IsSparse && LCSF_IsProtTrusted(pRegistry, pMessage->ProtId) &&
+                   LCSF_MapTrustedAttribute(pMessage, &(pProtDesc->pCmdDescArray[descCmdIdx]), &(validMsg.pAttArray));
+    if (!isValid) {
+        LifoFreeAll(LcsfValidatorInfo.pReceiverLifo);
+        validMsg.pAttArray = NULL;
+        // Check if command attributes are valid
+        isValid = LCSF_ValidateAttribute(pMessage, pProt, descCmdIdx, &(validMsg.pAttArray));
+    }
+    if (!isValid) {
+        LifoFreeAll(LcsfValidatorInfo.pReceiverLifo);
+        LCSF_ValidatorSendError(LCSF_EP_ERROR_LOC_VALIDATION_ERROR, LcsfValidatorInfo.LastErrorType, repr);
+        return LCSF_MapValidationError(LcsfValidatorInfo.LastErrorType);
+    }
+    // Send validated message to interpreter function
+    return LCSF_InterpretCmd(pFnInterpreter, &validMsg, repr) ? LCSF_RECEIVE_OK : LCSF_RECEIVE_ERROR;
 }
 
 // *** Public Functions ***
@@ -761,15 +2101,45 @@ bool LCSF_ValidatorInit(LCSFSendErrCallback_t *pFnSendErrCb, LCSFReceiveErrCallb
         LcsfValidatorInfo.pFnRecErrCb = pFnRecErrCb;
     }
     // Initialize structures
-    if (!LifoInit(&LcsfValidatorInfo.SenderLifo, SenderLifoData, LCSF_VALIDATOR_TX_LIFO_SIZE, sizeof(lcsf_raw_att_t))) {
+#ifdef LCSF_SHARED_ARENA
+    if (!LifoInitRegion(&LcsfValidatorInfo.SenderLifo, &LcsfSharedArena, sizeof(lcsf_raw_att_t))) {
         return false;
     }
-    if (!LifoInit(
-            &LcsfValidatorInfo.ReceiverLifo, ReceiverLifoData, LCSF_VALIDATOR_RX_LIFO_SIZE, sizeof(lcsf_valid_att_t))) {
+    if (!LifoInitRegion(&LcsfValidatorInfo.ReceiverLifoArray[0], &LcsfSharedArena, sizeof(lcsf_valid_att_t))) {
         return false;
     }
+#else
+    if (!LifoInit(&LcsfValidatorInfo.SenderLifo, SenderLifoData, LCSF_VALIDATOR_TX_LIFO_SIZE, sizeof(lcsf_raw_att_t))) {
+        return false;
+    }
+    for (uint16_t idx = 0; idx < LCSF_VALIDATOR_RX_GEN_NB; idx++) {
+        if (!LifoInit(&LcsfValidatorInfo.ReceiverLifoArray[idx], ReceiverLifoData[idx], LCSF_VALIDATOR_RX_LIFO_SIZE,
+                sizeof(lcsf_valid_att_t))) {
+            return false;
+        }
+    }
+#endif
+    for (uint16_t idx = 0; idx < LCSF_VALIDATOR_RX_GEN_NB; idx++) {
+        LCSF_ATOMIC_STORE(&LcsfValidatorInfo.IsHeldArray[idx], false);
+        LcsfValidatorInfo.IsInterpretingArray[idx] = false;
+    }
+    LcsfValidatorInfo.RxGenIdx = 0;
+    LcsfValidatorInfo.SendRepr = LCSF_REPR_DEFAULT;
+    LcsfValidatorInfo.pReceiverLifo = &(LcsfValidatorInfo.ReceiverLifoArray[0]);
+    // Error message templates are encoded by the first error sent
+    LcsfValidatorInfo.ErrTemplateArray[LCSF_REPR_STANDARD].IsEncoded = false;
+    LcsfValidatorInfo.ErrTemplateArray[LCSF_REPR_SMALL].IsEncoded = false;
     // Initialize variables
     LcsfValidatorInfo.ProtNb = LCSF_VALIDATOR_PROTOCOL_NB;
+    memset(LcsfValidatorInfo.RegistryArray, 0, sizeof(LcsfValidatorInfo.RegistryArray));
+    LCSF_ATOMIC_STORE(&LcsfValidatorInfo.pRegistry, &(LcsfValidatorInfo.RegistryArray[0]));
+    memset(LcsfValidatorInfo.ReaderArray, 0, sizeof(LcsfValidatorInfo.ReaderArray));
+#if (LCSF_VALIDATOR_SHAPE_CACHE_NB > 0)
+    memset(LcsfValidatorInfo.ShapeArray, 0, sizeof(LcsfValidatorInfo.ShapeArray));
+    LcsfValidatorInfo.NextShapeIdx = 0;
+    LcsfValidatorInfo.ShapeGeneration = 0;
+    memset(&LcsfValidatorInfo.ShapeStats, 0, sizeof(lcsf_shape_cache_stats_t));
+#endif
     return true;
 }
 
@@ -778,53 +2148,103 @@ bool LCSF_ValidatorAddProtocol(uint_fast16_t protIdx, const lcsf_validator_proto
     if ((pProtDesc == NULL) || (protIdx >= LcsfValidatorInfo.ProtNb)) {
         return false;
     }
-    // Add protocol descriptor
-    LcsfValidatorInfo.pProtArray[protIdx] = pProtDesc;
+    // Readers may still hold the spare snapshot
+    lcsf_registry_t *pRegistry = LCSF_BeginRegistryUpdate();
+    if (pRegistry == NULL) {
+        return false;
+    }
+    // Add protocol descriptor, without command filter nor trusted link
+    pRegistry->pProtArray[protIdx] = pProtDesc;
+    pRegistry->pCmdFilterArray[protIdx] = NULL;
+    pRegistry->CmdFilterSizeArray[protIdx] = 0;
+    pRegistry->IsTrustedArray[protIdx] = false;
+    // Note the fixed layout commands, sparse protocols always use the generic decoding
+    LCSF_AddFixedCommands(pRegistry, protIdx, pProtDesc->IsSparse ? NULL : pProtDesc->pProtDesc);
+    LCSF_PublishRegistry(pRegistry);
     return true;
 }
 
-lcsf_receive_status_t LCSF_ValidatorReceive(const lcsf_raw_msg_t *pMessage) {
+bool LCSF_ValidatorSetCmdFilter(uint_fast16_t protIdx, const uint8_t *pCmdIdBitmap, size_t cmdIdNb) {
     // Bad parameters guard
-    if (pMessage == NULL) {
-        return LCSF_RECEIVE_ERROR;
+    if ((protIdx >= LcsfValidatorInfo.ProtNb) || (cmdIdNb > UINT16_MAX)) {
+        return false;
     }
-    // Process lcsf error messages
-    if (pMessage->ProtId == LCSF_ERROR_PROTOCOL_ID) {
-        return LCSF_ProcessReceivedError(pMessage) ? LCSF_RECEIVE_OK : LCSF_RECEIVE_ERROR;
+    // Readers may still hold the spare snapshot
+    lcsf_registry_t *pRegistry = LCSF_BeginRegistryUpdate();
+    if (pRegistry == NULL) {
+        return false;
     }
-    // Retrieve protocol entry (bundles callback, descriptor and version)
-    const lcsf_validator_protocol_desc_t *pProt = LCSF_GetProtEntry(pMessage->ProtId);
-    // Check if protocol id is valid
-    if ((pProt == NULL) || (pProt->pProtDesc == NULL) || (pProt->pFnInterpretMsg == NULL)) {
-        LCSF_ValidatorSendError(LCSF_EP_ERROR_LOC_VALIDATION_ERROR, LCSF_EP_ERROR_CODE_UNKNOWN_PROT_ID);
-        return LCSF_MapValidationError(LCSF_EP_ERROR_CODE_UNKNOWN_PROT_ID);
+    // Note command filter
+    pRegistry->pCmdFilterArray[protIdx] = pCmdIdBitmap;
+    pRegistry->CmdFilterSizeArray[protIdx] = (pCmdIdBitmap != NULL) ? (uint16_t)cmdIdNb : 0;
+    LCSF_PublishRegistry(pRegistry);
+    return true;
+}
+
+bool LCSF_ValidatorSetTrusted(uint_fast16_t protIdx, bool isTrusted) {
+    // Bad parameters guard
+    if (protIdx >= LcsfValidatorInfo.ProtNb) {
+        return false;
     }
-    // Check if protocol version matches
-    if (pMessage->ProtVer != pProt->ProtVer) {
-        LCSF_ValidatorSendError(LCSF_EP_ERROR_LOC_VALIDATION_ERROR, LCSF_EP_ERROR_CODE_BAD_PROT_VER);
-        return LCSF_MapValidationError(LCSF_EP_ERROR_CODE_BAD_PROT_VER);
+    // Readers may still hold the spare snapshot
+    lcsf_registry_t *pRegistry = LCSF_BeginRegistryUpdate();
+    if (pRegistry == NULL) {
+        return false;
     }
-    const lcsf_protocol_desc_t *pProtDesc = pProt->pProtDesc;
-    LCSFInterpretCallback_t *pFnInterpreter = pProt->pFnInterpretMsg;
-    // Variables initialization
-    uint16_t descCmdIdx = 0;
-    lcsf_valid_cmd_t validMsg;
-    LifoFreeAll(&LcsfValidatorInfo.ReceiverLifo);
-    memset(&validMsg, 0, sizeof(lcsf_valid_cmd_t));
-    // Check if command id is valid
-    if (!LCSF_ValidateCmdId(pMessage->CmdId, pProtDesc->CmdNb, &descCmdIdx, pProtDesc->pCmdDescArray)) {
-        LCSF_ValidatorSendError(LCSF_EP_ERROR_LOC_VALIDATION_ERROR, LCSF_EP_ERROR_CODE_UNKNOWN_CMD_ID);
-        return LCSF_MapValidationError(LCSF_EP_ERROR_CODE_UNKNOWN_CMD_ID);
+    pRegistry->IsTrustedArray[protIdx] = isTrusted;
+    LCSF_PublishRegistry(pRegistry);
+    return true;
+}
+
+bool LCSF_ValidatorHoldCmd(uint_fast16_t *pGenIdx) {
+    // Bad parameters guard, the only generation can't be held
+    if ((pGenIdx == NULL) || (LCSF_VALIDATOR_RX_GEN_NB < 2) ||
+        !LcsfValidatorInfo.IsInterpretingArray[LcsfValidatorInfo.RxGenIdx]) {
+        return false;
     }
-    // Validate the command id
-    validMsg.CmdId = pMessage->CmdId;
-    // Check if command attributes are valid
-    if (!LCSF_ValidateAttribute(pMessage, &(pProtDesc->pCmdDescArray[descCmdIdx]), &(validMsg.pAttArray))) {
-        LCSF_ValidatorSendError(LCSF_EP_ERROR_LOC_VALIDATION_ERROR, LcsfValidatorInfo.LastErrorType);
-        return LCSF_MapValidationError(LcsfValidatorInfo.LastErrorType);
+    LCSF_ATOMIC_STORE(&LcsfValidatorInfo.IsHeldArray[LcsfValidatorInfo.RxGenIdx], true);
+    *pGenIdx = LcsfValidatorInfo.RxGenIdx;
+    return true;
+}
+
+bool LCSF_ValidatorReleaseCmd(uint_fast16_t genIdx) {
+    // Bad parameters guard
+    if ((genIdx >= LCSF_VALIDATOR_RX_GEN_NB) || !LCSF_ATOMIC_LOAD(&LcsfValidatorInfo.IsHeldArray[genIdx])) {
+        return false;
     }
-    // Send validated message to interpreter function
-    return pFnInterpreter(&validMsg) ? LCSF_RECEIVE_OK : LCSF_RECEIVE_ERROR;
+    // The lifo is freed when the generation is selected again
+    LCSF_ATOMIC_STORE(&LcsfValidatorInfo.IsHeldArray[genIdx], false);
+    return true;
+}
+
+bool LCSF_ValidatorIsRegistrySynced(void) {
+    for (uint8_t idx = 0; idx < LCSF_READER_NB; idx++) {
+        lcsf_registry_reader_t *pReader = &(LcsfValidatorInfo.ReaderArray[idx]);
+        uint32_t publishSeq = pReader->PublishSeq;
+        // The reader was in its section at publication and that section is not over
+        if (((publishSeq % 2) != 0) && (LCSF_ATOMIC_LOAD(&pReader->ReadSeq) == publishSeq)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+lcsf_receive_status_t LCSF_ValidatorReceive(const lcsf_raw_msg_t *pMessage) {
+    return LCSF_ValidatorReceiveRepr(pMessage, LCSF_REPR_DEFAULT);
+}
+
+lcsf_receive_status_t LCSF_ValidatorReceiveRepr(const lcsf_raw_msg_t *pMessage, lcsf_repr_t repr) {
+    // Bad parameters guard
+    if ((repr != LCSF_REPR_STANDARD) && (repr != LCSF_REPR_SMALL)) {
+        return LCSF_RECEIVE_ERROR;
+    }
+    // Receives nest from interpretation functions
+    uint16_t prevGenIdx = LcsfValidatorInfo.RxGenIdx;
+    const lcsf_registry_t *pRegistry = LCSF_EnterRegistry(LCSF_READER_RX);
+    lcsf_receive_status_t status = LCSF_ReadReceive(pRegistry, pMessage, repr);
+    LCSF_LeaveRegistry(LCSF_READER_RX);
+    LCSF_RestoreReceiverGen(prevGenIdx);
+    return status;
 }
 
 int LCSF_ValidatorEncode(uint_fast16_t protId, const lcsf_valid_cmd_t *pCommand, uint8_t *pBuffer, size_t buffSize) {
@@ -832,49 +2252,174 @@ int LCSF_ValidatorEncode(uint_fast16_t protId, const lcsf_valid_cmd_t *pCommand,
     if (pCommand == NULL) {
         return -1;
     }
-    // Retrieve protocol entry (bundles descriptor and version)
-    const lcsf_validator_protocol_desc_t *pProt = LCSF_GetProtEntry(protId);
-    if ((pProt == NULL) || (pProt->pProtDesc == NULL)) {
-        // Unknown protocol
+    lcsf_raw_msg_t sendMsg;
+    // Validate command and fill raw message
+    const lcsf_registry_t *pRegistry = LCSF_EnterRegistry(LCSF_READER_TX);
+    bool isFilled = LCSF_FillSendMsg(pRegistry, protId, pCommand, &sendMsg);
+    LCSF_LeaveRegistry(LCSF_READER_TX);
+    if (!isFilled) {
         return -1;
     }
-    const lcsf_protocol_desc_t *pProtDesc = pProt->pProtDesc;
-    // Variables initialization
-    uint16_t cmdIdx = 0;
+    // Pass message to transcoder
+    int msgSize = LCSF_TranscoderEncodeRepr(&sendMsg, pBuffer, buffSize, LcsfValidatorInfo.SendRepr);
+    // Free lifo
+    LifoFreeAll(&LcsfValidatorInfo.SenderLifo);
+    return msgSize;
+}
+
+bool LCSF_ValidatorPrepare(uint_fast16_t protId, const lcsf_valid_cmd_t *pCommand, uint8_t *pBuffer, size_t buffSize,
+    lcsf_prepared_att_t *pAttArray, size_t attArraySize, lcsf_prepared_cmd_t *pPrepared) {
+    // Bad parameters guard
+    if ((pCommand == NULL) || (pBuffer == NULL) || (pPrepared == NULL)) {
+        return false;
+    }
+    if ((pAttArray == NULL) && (attArraySize > 0)) {
+        return false;
+    }
     lcsf_raw_msg_t sendMsg;
-    memset(&sendMsg, 0, sizeof(lcsf_raw_msg_t));
+    // Validate command and fill raw message
+    const lcsf_registry_t *pRegistry = LCSF_EnterRegistry(LCSF_READER_TX);
+    bool isFilled = LCSF_FillSendMsg(pRegistry, protId, pCommand, &sendMsg);
+    LCSF_LeaveRegistry(LCSF_READER_TX);
+    if (!isFilled) {
+        return false;
+    }
+    // Encode message with the sent messages representation
+    int msgSize = LCSF_TranscoderEncodeRepr(&sendMsg, pBuffer, buffSize, LcsfValidatorInfo.SendRepr);
+    bool isSmall = (LcsfValidatorInfo.SendRepr == LCSF_REPR_SMALL);
+    size_t buffIdx = isSmall ? 4 : 8;
+    // Note the data layout from the raw message
+    pPrepared->pBuffer = pBuffer;
+    pPrepared->MsgSize = (msgSize > 0) ? (uint16_t)msgSize : 0;
+    pPrepared->ValuesSize = 0;
+    pPrepared->AttNb = 0;
+    pPrepared->pAttArray = pAttArray;
+    bool isPrepared = (msgSize > 0) && LCSF_PrepareAttribute_Rec(sendMsg.AttNb, sendMsg.pAttArray, isSmall ? 2 : 4,
+                                          &buffIdx, pPrepared, attArraySize);
+    // Free lifo
     LifoFreeAll(&LcsfValidatorInfo.SenderLifo);
-    // Note the protocol id and version
-    sendMsg.ProtId = protId;
-    sendMsg.ProtVer = pProt->ProtVer;
-    // Validate command id
-    if (!LCSF_ValidateCmdId(pCommand->CmdId, pProtDesc->CmdNb, &cmdIdx, pProtDesc->pCmdDescArray)) {
-        // Unknown command
+    return isPrepared;
+}
+
+int LCSF_ValidatorExecute(const lcsf_prepared_cmd_t *pPrepared, const uint8_t *pValues, size_t valuesSize) {
+    // Bad parameters guard
+    if ((pPrepared == NULL) || (pPrepared->MsgSize == 0) || ((pValues == NULL) && (valuesSize > 0))) {
         return -1;
     }
-    // Intermediary variable
-    const lcsf_command_desc_t *pCurrCmdDesc = &(pProtDesc->pCmdDescArray[cmdIdx]);
-    // Note the command id
-    sendMsg.CmdId = pCommand->CmdId;
-    // Retrieve attribute number
-    sendMsg.AttNb = LCSF_CountAttributes(pCurrCmdDesc->AttNb, pCommand->pAttArray);
-    // Validate attribute number
-    if (sendMsg.AttNb == 0) {
-        if (LCSF_HasNonOptionalAttribute(pCurrCmdDesc->AttNb, pCurrCmdDesc->pAttDescArray)) {
-            // Attributes are missing
-            return -1;
-        }
-        // No attributes needed, send the message
-        return LCSF_TranscoderEncode(&sendMsg, pBuffer, buffSize);
-    } else if (sendMsg.AttNb > pCurrCmdDesc->AttNb) {
-        // Too many attributes
+    // Values layout guard
+    if (valuesSize != pPrepared->ValuesSize) {
         return -1;
     }
-    // Fill message attributes array
-    if (!LCSF_FillAttributeArray(sendMsg.AttNb, pCommand->pAttArray, pCurrCmdDesc, &(sendMsg.pAttArray))) {
-        // Attribute error
+    // Patch the attributes data in message order
+    LCSF_PatchPreparedData(pPrepared, pValues, pPrepared->pBuffer);
+    return pPrepared->MsgSize;
+}
+
+int LCSF_ValidatorExecuteCopy(const lcsf_prepared_cmd_t *pPrepared, const uint8_t *pValues, size_t valuesSize,
+    uint8_t *pBuffer, size_t buffSize) {
+    // Bad parameters guard
+    if ((pPrepared == NULL) || (pPrepared->MsgSize == 0) || ((pValues == NULL) && (valuesSize > 0)) ||
+        (pBuffer == NULL)) {
         return -1;
     }
-    // Pass message to transcoder
-    return LCSF_TranscoderEncode(&sendMsg, pBuffer, buffSize);
-}
\ No newline at end of file
+    // Values layout and buffer size guard
+    if ((valuesSize != pPrepared->ValuesSize) || (buffSize < pPrepared->MsgSize)) {
+        return -1;
+    }
+    // Copy the prepared message then patch the attributes data in message order
+    memcpy(pBuffer, pPrepared->pBuffer, pPrepared->MsgSize);
+    LCSF_PatchPreparedData(pPrepared, pValues, pBuffer);
+    return pPrepared->MsgSize;
+}
+
+bool LCSF_ValidatorPackDesc(const lcsf_protocol_desc_t *pProtDesc, lcsf_packed_cmd_desc_t *pCmdArray,
+    size_t cmdArraySize, lcsf_packed_att_desc_t *pAttArray, size_t attArraySize, lcsf_packed_prot_desc_t *pPackedDesc) {
+    // Bad parameters guard
+    if ((pProtDesc == NULL) || (pProtDesc->pCmdDescArray == NULL) || (pCmdArray == NULL) || (pAttArray == NULL) ||
+        (pPackedDesc == NULL)) {
+        return false;
+    }
+    if (pProtDesc->CmdNb > cmdArraySize) {
+        return false;
+    }
+    size_t nextIdx = 0;
+    for (uint16_t idx = 0; idx < pProtDesc->CmdNb; idx++) {
+        const lcsf_command_desc_t *pCmdDesc = &(pProtDesc->pCmdDescArray[idx]);
+        // Reserve the command attribute level
+        if (((nextIdx + pCmdDesc->AttNb) > attArraySize) || (nextIdx > 0xFFFF)) {
+            return false;
+        }
+        pCmdArray[idx].CmdId = pCmdDesc->CmdId;
+        pCmdArray[idx].AttNb = pCmdDesc->AttNb;
+        pCmdArray[idx].AttIdx = (uint16_t)nextIdx;
+        nextIdx += pCmdDesc->AttNb;
+        if (!LCSF_PackAttDesc_Rec(
+                pCmdDesc->AttNb, pCmdDesc->pAttDescArray, pCmdArray[idx].AttIdx, pAttArray, attArraySize, &nextIdx)) {
+            return false;
+        }
+    }
+    pPackedDesc->CmdNb = pProtDesc->CmdNb;
+    pPackedDesc->pCmdArray = pCmdArray;
+    pPackedDesc->pAttArray = pAttArray;
+    return true;
+}
+
+lcsf_valid_att_t *LCSF_ValidatorGetSparseAtt(
+    const lcsf_valid_att_t *pAttArray, uint_fast16_t descAttNb, uint_fast16_t descIdx) {
+    // Bad parameters guard
+    if ((pAttArray == NULL) || (descIdx >= descAttNb)) {
+        return NULL;
+    }
+    // Check attribute presence
+    const lcsf_sparse_word_t *pWordArray = (const void *)pAttArray;
+    const lcsf_sparse_word_t *pWord = &(pWordArray[descIdx / 32]);
+    uint32_t bitMask = (uint32_t)1 << (descIdx % 32);
+    if ((pWord->Bitmap & bitMask) == 0) {
+        return NULL;
+    }
+    // Rank of the attribute among the present attributes
+    uint_fast16_t rank = pWord->Rank + LCSF_CountBits(pWord->Bitmap & (bitMask - 1));
+    return (lcsf_valid_att_t *)&(pAttArray[LCSF_SPARSE_ITEM_NB(descAttNb) + rank]);
+}
+
+bool LCSF_ValidatorGetShapeCacheStats(lcsf_shape_cache_stats_t *pStats) {
+#if (LCSF_VALIDATOR_SHAPE_CACHE_NB > 0)
+    // Bad parameters guard
+    if (pStats == NULL) {
+        return false;
+    }
+    memcpy(pStats, &LcsfValidatorInfo.ShapeStats, sizeof(lcsf_shape_cache_stats_t));
+    return true;
+#else
+    (void)pStats;
+    return false;
+#endif
+}
+
+bool LCSF_ValidatorGetDescUsage(const lcsf_protocol_desc_t *pProtDesc, lcsf_desc_usage_t *pUsage) {
+    // Bad parameters guard
+    if ((pProtDesc == NULL) || (pUsage == NULL) || (pProtDesc->pCmdDescArray == NULL)) {
+        return false;
+    }
+    uint32_t maxItemNb = 0;
+    uint16_t maxDepth = 0;
+    // Parse commands, each lifo holds at most the full attribute tree of one command
+    for (uint16_t idx = 0; idx < pProtDesc->CmdNb; idx++) {
+        const lcsf_command_desc_t *pCmdDesc = &(pProtDesc->pCmdDescArray[idx]);
+        uint32_t itemNb = LCSF_GetAttDescUsage_Rec(pCmdDesc->AttNb, pCmdDesc->pAttDescArray, 1, &maxDepth);
+        if (itemNb > maxItemNb) {
+            maxItemNb = itemNb;
+        }
+    }
+    // Check lifo item number limit
+    if (maxItemNb > UINT16_MAX) {
+        return false;
+    }
+    pUsage->ValidatorRxItemNb = (uint16_t)maxItemNb;
+    pUsage->ValidatorTxItemNb = (uint16_t)maxItemNb;
+    pUsage->BridgeItemNb = (uint16_t)maxItemNb;
+    // The transcoder also decodes the received LCSF_EP error messages
+    pUsage->TranscoderRxItemNb = (maxItemNb > LCSF_EP_CMD_ERROR_ATT_NB) ? (uint16_t)maxItemNb : LCSF_EP_CMD_ERROR_ATT_NB;
+    pUsage->MaxDepth = maxDepth;
+    return true;
+}
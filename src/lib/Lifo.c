@@ -37,11 +37,101 @@
 #define MAX_VLE_VALUE_7B 0x00ffffffffffffff
 // --- Private Constants ---
 // --- Private Function Prototypes ---
+static bool LifoGetRegion(lifo_desc_t *pRegion, size_t itemNb, void **pFreeSlot);
+static bool LifoFreeAllRegion(lifo_desc_t *pRegion);
+static bool LifoGetAllocator(lifo_desc_t *pLifoDesc, size_t itemNb, void **pFreeSlot);
+
+// --- Public Variables ---
+#ifdef LCSF_SHARED_ARENA
+lifo_desc_t LcsfSharedArena;
+#endif
+
 // --- Private Variables ---
 // *** End Definitions ***
 
 // *** Private Functions ***
 
+/**
+ * \fn static bool LifoGetRegion(lifo_desc_t *pRegion, size_t itemNb, void **pFreeSlot)
+ * \brief Allocate a table of item from a region lifo arena
+ *
+ * \param pRegion pointer to the region lifo
+ * \param itemNb number of items
+ * \param pFreeSlot pointer to contain the item table pointer
+ * \return bool: true if operation was a success
+ */
+static bool LifoGetRegion(lifo_desc_t *pRegion, size_t itemNb, void **pFreeSlot) {
+    lifo_desc_t *pArena = pRegion->pArena;
+    // Uninitialized arena or overflow guard
+    if ((pArena->ItemSize == 0) || (itemNb > pRegion->FreeItemNb)) {
+        *pFreeSlot = NULL;
+        return false;
+    }
+    // Round allocation up to arena items
+    size_t arenaItemNb = (itemNb * pRegion->ItemSize + pArena->ItemSize - 1) / pArena->ItemSize;
+    uint16_t arenaTakenNb = pArena->ItemNb - pArena->FreeItemNb;
+    if (!LifoGet(pArena, arenaItemNb, pFreeSlot)) {
+        return false;
+    }
+    // Note the arena mark on the region first allocation
+    if (pRegion->FreeItemNb == pRegion->ItemNb) {
+        pRegion->ArenaMark = arenaTakenNb;
+    }
+    // Take allocation into account
+    pRegion->FreeItemNb -= itemNb;
+    return true;
+}
+
+/**
+ * \fn static bool LifoFreeAllRegion(lifo_desc_t *pRegion)
+ * \brief Free all items from a region lifo, releasing its arena down to the region mark
+ *
+ * \param pRegion pointer to the region lifo
+ * \return bool: true if operation was a success
+ */
+static bool LifoFreeAllRegion(lifo_desc_t *pRegion) {
+    lifo_desc_t *pArena = pRegion->pArena;
+    // Empty region guard
+    if (pRegion->FreeItemNb == pRegion->ItemNb) {
+        return true;
+    }
+    uint16_t arenaTakenNb = pArena->ItemNb - pArena->FreeItemNb;
+    // Release the arena down to the mark (outer regions might already have released it)
+    if (arenaTakenNb > pRegion->ArenaMark) {
+        LifoFree(pArena, arenaTakenNb - pRegion->ArenaMark);
+    }
+    // Clear the region
+    pRegion->FreeItemNb = pRegion->ItemNb;
+    return true;
+}
+
+/**
+ * \fn static bool LifoGetAllocator(lifo_desc_t *pLifoDesc, size_t itemNb, void **pFreeSlot)
+ * \brief Allocate a table of item from an allocator lifo
+ *
+ * \param pLifoDesc pointer to the allocator lifo
+ * \param itemNb number of items
+ * \param pFreeSlot pointer to contain the item table pointer
+ * \return bool: true if operation was a success
+ */
+static bool LifoGetAllocator(lifo_desc_t *pLifoDesc, size_t itemNb, void **pFreeSlot) {
+    const lifo_allocator_t *pAllocator = pLifoDesc->pAllocator;
+    // Item counter overflow guard
+    if (itemNb > pLifoDesc->FreeItemNb) {
+        *pFreeSlot = NULL;
+        return false;
+    }
+    // Allocate memory
+    *pFreeSlot = pAllocator->pFnGet(pAllocator->pUser, itemNb * pLifoDesc->ItemSize);
+    if (*pFreeSlot == NULL) {
+        // Out of memory
+        return false;
+    }
+    // Take allocation into account
+    pLifoDesc->FreeItemNb -= itemNb;
+    return true;
+}
+
 // *** Public Functions ***
 
 bool LifoInit(lifo_desc_t *pLifo, void *pData, size_t itemNb, size_t itemSize) {
@@ -54,9 +144,47 @@ bool LifoInit(lifo_desc_t *pLifo, void *pData, size_t itemNb, size_t itemSize) {
     }
     // Lifo Initialization
     pLifo->pDataArray = pData;
+    pLifo->pArena = NULL;
+    pLifo->pAllocator = NULL;
     pLifo->ItemSize = itemSize;
     pLifo->ItemNb = itemNb;
     pLifo->FreeItemNb = itemNb;
+    pLifo->ArenaMark = 0;
+    return true;
+}
+
+bool LifoInitAllocator(lifo_desc_t *pLifo, const lifo_allocator_t *pAllocator, size_t itemSize) {
+    // Bad parameters guard
+    if ((pLifo == NULL) || (pAllocator == NULL) || (itemSize == 0)) {
+        return false;
+    }
+    if ((pAllocator->pFnGet == NULL) || (pAllocator->pFnFreeAll == NULL)) {
+        return false;
+    }
+    // Lifo Initialization, capacity is only limited by the allocator
+    pLifo->pDataArray = NULL;
+    pLifo->pArena = NULL;
+    pLifo->pAllocator = pAllocator;
+    pLifo->ItemSize = itemSize;
+    pLifo->ItemNb = UINT16_MAX;
+    pLifo->FreeItemNb = UINT16_MAX;
+    pLifo->ArenaMark = 0;
+    return true;
+}
+
+bool LifoInitRegion(lifo_desc_t *pLifo, lifo_desc_t *pArena, size_t itemSize) {
+    // Bad parameters guard
+    if ((pLifo == NULL) || (pArena == NULL) || (pArena == pLifo) || (itemSize == 0)) {
+        return false;
+    }
+    // Region Initialization, capacity is only limited by the arena
+    pLifo->pDataArray = NULL;
+    pLifo->pArena = pArena;
+    pLifo->pAllocator = NULL;
+    pLifo->ItemSize = itemSize;
+    pLifo->ItemNb = UINT16_MAX;
+    pLifo->FreeItemNb = UINT16_MAX;
+    pLifo->ArenaMark = 0;
     return true;
 }
 
@@ -65,6 +193,14 @@ bool LifoGet(lifo_desc_t *pLifoDesc, size_t itemNb, void **pFreeSlot) {
     if ((pLifoDesc == NULL) || (pFreeSlot == NULL)) {
         return false;
     }
+    // Region lifo
+    if (pLifoDesc->pArena != NULL) {
+        return LifoGetRegion(pLifoDesc, itemNb, pFreeSlot);
+    }
+    // Allocator lifo
+    if (pLifoDesc->pAllocator != NULL) {
+        return LifoGetAllocator(pLifoDesc, itemNb, pFreeSlot);
+    }
     // Overflow guard
     if (itemNb > pLifoDesc->FreeItemNb) {
         // Out of memory
@@ -82,7 +218,7 @@ bool LifoGet(lifo_desc_t *pLifoDesc, size_t itemNb, void **pFreeSlot) {
 
 bool LifoFree(lifo_desc_t *pLifoDesc, size_t itemNb) {
     // Bad parameters guard
-    if (pLifoDesc == NULL) {
+    if ((pLifoDesc == NULL) || (pLifoDesc->pArena != NULL)) {
         return false;
     }
     // Calc number of taken slots
@@ -93,6 +229,10 @@ bool LifoFree(lifo_desc_t *pLifoDesc, size_t itemNb) {
     }
     // Take liberation into account
     pLifoDesc->FreeItemNb += itemNb;
+    // Allocator memory is only released once the lifo is empty
+    if ((pLifoDesc->pAllocator != NULL) && (pLifoDesc->FreeItemNb == pLifoDesc->ItemNb) && (itemNb > 0)) {
+        pLifoDesc->pAllocator->pFnFreeAll(pLifoDesc->pAllocator->pUser);
+    }
     return true;
 }
 
@@ -101,6 +241,14 @@ bool LifoFreeAll(lifo_desc_t *pLifoDesc) {
     if (pLifoDesc == NULL) {
         return false;
     }
+    // Region lifo
+    if (pLifoDesc->pArena != NULL) {
+        return LifoFreeAllRegion(pLifoDesc);
+    }
+    // Allocator lifo
+    if ((pLifoDesc->pAllocator != NULL) && (pLifoDesc->FreeItemNb != pLifoDesc->ItemNb)) {
+        pLifoDesc->pAllocator->pFnFreeAll(pLifoDesc->pAllocator->pUser);
+    }
     // Clear the lifo
     pLifoDesc->FreeItemNb = pLifoDesc->ItemNb;
     return true;
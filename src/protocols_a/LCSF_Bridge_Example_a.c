@@ -34,7 +34,9 @@
 
 // Module information structure
 typedef struct _lcsf_bridge_example_info {
+#ifndef LCSF_SHARED_ARENA
     uint8_t LifoData[LCSF_EXAMPLE_BRIDGE_LIFO_SIZE * sizeof(lcsf_valid_att_t)];
+#endif
     lifo_desc_t Lifo;
     example_cmd_payload_t CmdPayload;
 } lcsf_bridge_example_info_t;
@@ -269,8 +271,12 @@ static bool LCSF_Bridge_ExampleFillCmdAtt(
 // *** Public Functions ***
 
 bool LCSF_Bridge_ExampleInit(void) {
+#ifdef LCSF_SHARED_ARENA
+    return LifoInitRegion(&LcsfBridgeExampleInfo.Lifo, &LcsfSharedArena, sizeof(lcsf_valid_att_t));
+#else
     return LifoInit(&LcsfBridgeExampleInfo.Lifo, LcsfBridgeExampleInfo.LifoData, LCSF_EXAMPLE_BRIDGE_LIFO_SIZE,
         sizeof(lcsf_valid_att_t));
+#endif
 }
 
 bool LCSF_Bridge_ExampleReceive(lcsf_valid_cmd_t *pValidCmd) {
@@ -284,10 +290,13 @@ bool LCSF_Bridge_ExampleReceive(lcsf_valid_cmd_t *pValidCmd) {
 int LCSF_Bridge_ExampleEncode(uint_fast16_t cmdName, example_cmd_payload_t *pCmdPayload, uint8_t *pBuffer, size_t buffSize) {
     lcsf_valid_cmd_t sendCmd;
     sendCmd.CmdId = LCSF_Bridge_Example_CMDNAME2CMDID[cmdName];
+    int msgSize = -1;
     LifoFreeAll(&LcsfBridgeExampleInfo.Lifo);
 
-    if (!LCSF_Bridge_ExampleFillCmdAtt(cmdName, &(sendCmd.pAttArray), pCmdPayload)) {
-        return -1;
+    if (LCSF_Bridge_ExampleFillCmdAtt(cmdName, &(sendCmd.pAttArray), pCmdPayload)) {
+        msgSize = LCSF_ValidatorEncode(LCSF_EXAMPLE_PROTOCOL_ID, &sendCmd, pBuffer, buffSize);
     }
-    return LCSF_ValidatorEncode(LCSF_EXAMPLE_PROTOCOL_ID, &sendCmd, pBuffer, buffSize);
+    // Free lifo
+    LifoFreeAll(&LcsfBridgeExampleInfo.Lifo);
+    return msgSize;
 }
\ No newline at end of file
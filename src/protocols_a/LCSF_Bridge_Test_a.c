@@ -17,7 +17,9 @@
 // *** Definitions ***
 // --- Private Types ---
 
+#ifndef LCSF_SHARED_ARENA
 static uint8_t LifoData[LCSF_BRIDGE_TEST_LIFO_SIZE * sizeof(lcsf_valid_att_t)];
+#endif
 
 // Module information structure
 typedef struct _lcsf_bridge_test_info {
@@ -816,7 +818,11 @@ static bool LCSF_Bridge_TestFillCmdAtt(
 // *** Public Functions ***
 
 bool LCSF_Bridge_TestInit(void) {
+#ifdef LCSF_SHARED_ARENA
+    return LifoInitRegion(&LcsfBridgeTestInfo.Lifo, &LcsfSharedArena, sizeof(lcsf_valid_att_t));
+#else
     return LifoInit(&LcsfBridgeTestInfo.Lifo, LifoData, LCSF_BRIDGE_TEST_LIFO_SIZE, sizeof(lcsf_valid_att_t));
+#endif
 }
 
 bool LCSF_Bridge_TestReceive(lcsf_valid_cmd_t *pValidCmd) {
@@ -832,10 +838,13 @@ bool LCSF_Bridge_TestReceive(lcsf_valid_cmd_t *pValidCmd) {
 int LCSF_Bridge_TestEncode(uint_fast16_t cmdName, test_cmd_payload_t *pCmdPayload, uint8_t *pBuffer, size_t buffSize) {
     lcsf_valid_cmd_t sendCmd;
     sendCmd.CmdId = LCSF_Bridge_Test_CMDNAME2CMDID[cmdName];
+    int msgSize = -1;
     LifoFreeAll(&LcsfBridgeTestInfo.Lifo);
 
-    if (!LCSF_Bridge_TestFillCmdAtt(cmdName, &(sendCmd.pAttArray), pCmdPayload)) {
-        return -1;
+    if (LCSF_Bridge_TestFillCmdAtt(cmdName, &(sendCmd.pAttArray), pCmdPayload)) {
+        msgSize = LCSF_ValidatorEncode(LCSF_TEST_PROTOCOL_ID, &sendCmd, pBuffer, buffSize);
     }
-    return LCSF_ValidatorEncode(LCSF_TEST_PROTOCOL_ID, &sendCmd, pBuffer, buffSize);
+    // Free lifo
+    LifoFreeAll(&LcsfBridgeTestInfo.Lifo);
+    return msgSize;
 }
@@ -0,0 +1,130 @@
+/**
+ * \file sizing_main.c
+ * \brief Host tool computing the LCSF C Stack worst-case lifo sizes and stack usage.
+ * \author Jean-Roland Gosse
+
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ */
+
+// *** Libraries include ***
+// Standard lib
+#include <stdio.h>
+// Custom lib
+#include <lib/LCSF_Validator.h>
+#include <protocols/LCSF_Bridge_Example.h>
+#include "LCSF_Bridge_Test.h"
+
+// *** Module definitions ***
+
+// Stack cost per recursive call (bytes), see Resource_usage.md, adjust to your target and toolchain
+#define DECODE_ATT_REC_STACK_COST 40
+#define VALIDATE_ATT_REC_STACK_COST 56
+#define FILL_ATT_REC_STACK_COST 48
+#define ENCODE_ATT_REC_STACK_COST 24
+// Stack cost outside of recursive functions (bytes), lcsf stack + protocol
+#define NON_REC_STACK_COST (160 + 112)
+
+// Protocol table entry
+typedef struct _sizing_protocol_entry {
+    const char *pLifoSizeName; // Name of the protocol bridge lifo size define
+    const lcsf_protocol_desc_t *pProtDesc; // Pointer to the protocol descriptor
+} sizing_protocol_entry_t;
+
+// *** End of module definitions ***
+
+// Functions
+
+/**
+ * \fn static uint_fast16_t get_max_rec_stack_cost(void)
+ * \brief Retrieve the per call cost of the recursive functions, at the worst nesting point
+ *
+ * Decoding and validation recursions run one after another, as do filling and encoding ones. An interpretation
+ * function replying to a message encodes on top of the receive callstack, so the largest costs of each side add up.
+ *
+ * \return uint_fast16_t: stack cost in bytes
+ */
+static uint_fast16_t get_max_rec_stack_cost(void) {
+    uint_fast16_t rxCost = DECODE_ATT_REC_STACK_COST;
+    if (VALIDATE_ATT_REC_STACK_COST > rxCost) {
+        rxCost = VALIDATE_ATT_REC_STACK_COST;
+    }
+    uint_fast16_t txCost = FILL_ATT_REC_STACK_COST;
+    if (ENCODE_ATT_REC_STACK_COST > txCost) {
+        txCost = ENCODE_ATT_REC_STACK_COST;
+    }
+    return rxCost + txCost;
+}
+
+/**
+ * \fn void main(void)
+ * \brief Program entry
+ *
+ * \return int: 0 if successful
+ */
+int main(void) {
+    // Protocols used by the application (edit to match your project)
+    const sizing_protocol_entry_t protArray[] = {
+        {"LCSF_EXAMPLE_BRIDGE_LIFO_SIZE", &LCSF_Example_ProtDesc},
+        {"LCSF_BRIDGE_TEST_LIFO_SIZE", LCSF_Test_ProtDesc.pProtDesc},
+    };
+    const size_t protNb = sizeof(protArray) / sizeof(sizing_protocol_entry_t);
+    lcsf_desc_usage_t maxUsage = {0};
+    lcsf_desc_usage_t usage;
+    uint32_t bridgeItemSum = 0;
+
+    printf("// --- Protocol bridges ---\n");
+    for (size_t idx = 0; idx < protNb; idx++) {
+        if (!LCSF_ValidatorGetDescUsage(protArray[idx].pProtDesc, &usage)) {
+            printf("Invalid descriptor for %s\n", protArray[idx].pLifoSizeName);
+            return 1;
+        }
+        printf("#define %s %u // Max depth: %u\n", protArray[idx].pLifoSizeName, usage.BridgeItemNb, usage.MaxDepth);
+        bridgeItemSum += usage.BridgeItemNb;
+        // Lcsf stack lifos are shared between protocols
+        if (usage.TranscoderRxItemNb > maxUsage.TranscoderRxItemNb) {
+            maxUsage.TranscoderRxItemNb = usage.TranscoderRxItemNb;
+        }
+        if (usage.ValidatorRxItemNb > maxUsage.ValidatorRxItemNb) {
+            maxUsage.ValidatorRxItemNb = usage.ValidatorRxItemNb;
+        }
+        if (usage.ValidatorTxItemNb > maxUsage.ValidatorTxItemNb) {
+            maxUsage.ValidatorTxItemNb = usage.ValidatorTxItemNb;
+        }
+        if (usage.BridgeItemNb > maxUsage.BridgeItemNb) {
+            maxUsage.BridgeItemNb = usage.BridgeItemNb;
+        }
+        if (usage.MaxDepth > maxUsage.MaxDepth) {
+            maxUsage.MaxDepth = usage.MaxDepth;
+        }
+    }
+    printf("\n// --- LCSF Transcoder ---\n");
+    printf("#define LCSF_TRANSCODER_RX_LIFO_SIZE %u\n", maxUsage.TranscoderRxItemNb);
+    printf("\n// --- LCSF Validator ---\n");
+    printf("#define LCSF_VALIDATOR_TX_LIFO_SIZE %u\n", maxUsage.ValidatorTxItemNb);
+    printf("#define LCSF_VALIDATOR_RX_LIFO_SIZE %u\n", maxUsage.ValidatorRxItemNb);
+    printf("#define LCSF_VALIDATOR_PROTOCOL_NB %u\n", (unsigned int)protNb);
+    // With a shared arena, only one bridge lifo is in use at a time
+    uint32_t stackItemSum = maxUsage.TranscoderRxItemNb + maxUsage.ValidatorRxItemNb + maxUsage.ValidatorTxItemNb;
+    printf("\n// --- LCSF Lifo ---\n");
+    // Item size depends on the host pointer size
+    size_t itemSize =
+        (sizeof(lcsf_raw_att_t) > sizeof(lcsf_valid_att_t)) ? sizeof(lcsf_raw_att_t) : sizeof(lcsf_valid_att_t);
+    printf("// Separate lifos: %u items, LCSF_SHARED_ARENA: %u items (%u bytes / item)\n",
+        (unsigned int)(stackItemSum + bridgeItemSum), (unsigned int)(stackItemSum + maxUsage.BridgeItemNb),
+        (unsigned int)itemSize);
+    printf("\n// Worst-case stack usage, with replies: %u bytes (%u nested calls of %u bytes + %u bytes)\n",
+        (unsigned int)(NON_REC_STACK_COST + maxUsage.MaxDepth * get_max_rec_stack_cost()), maxUsage.MaxDepth,
+        (unsigned int)get_max_rec_stack_cost(), NON_REC_STACK_COST);
+    return 0;
+}
@@ -21,6 +21,18 @@
 
 #include "CppUTest/CommandLineTestRunner.h"
 
+extern "C" {
+#include "LCSF_Config.h"
+#include "LCSF_Validator.h"
+#include "Lifo.h"
+}
+
+#ifdef LCSF_SHARED_ARENA
+// Shared arena, sized for the concurrent transcoder, validator and bridge lifos worst case
+#define ARENA_ITEM_NB (4 * LCSF_TRANSCODER_RX_LIFO_SIZE)
+static lcsf_valid_att_t ArenaData[ARENA_ITEM_NB];
+#endif
+
 /**
  * @brief      main function
  *
@@ -30,5 +42,8 @@
  * @return     int: execution status
  */
 int main(int argc, const char **argv) {
+#ifdef LCSF_SHARED_ARENA
+    LifoInit(&LcsfSharedArena, ArenaData, ARENA_ITEM_NB, sizeof(lcsf_valid_att_t));
+#endif
     return RUN_ALL_TESTS(argc, argv);
 }
@@ -512,3 +512,98 @@ TEST(A_Test_Fullstack, errors) {
     expect_senderr_cb(err_bad_prot_ver_msg, sizeof(err_bad_prot_ver_msg));
     CHECK(LCSF_TranscoderReceive(bad_version_msg, sizeof(bad_version_msg)) == LCSF_RECEIVE_BAD_PROT_VER);
 }
+
+/**
+ * testgroup: A_Test_Fullstack
+ * testname: filter
+ *
+ * Test the command subscription filter
+ */
+TEST(A_Test_Fullstack, filter) {
+    // Subscribe to SC2 only (command id 0x01)
+    static const uint8_t cmdFilter[] = {0x02};
+    CHECK_FALSE(LCSF_ValidatorSetCmdFilter(LCSF_VALIDATOR_PROTOCOL_NB, cmdFilter, 8));
+    CHECK(LCSF_ValidatorSetCmdFilter(0, cmdFilter, 8));
+    // Unsubscribed commands are dropped without decoding nor error message
+    CHECK(LCSF_TranscoderReceive(sc3_msg, sizeof(sc3_msg)) == LCSF_RECEIVE_FILTERED);
+    CHECK(LCSF_TranscoderReceive(bad_cmd_id_msg, sizeof(bad_cmd_id_msg)) == LCSF_RECEIVE_FILTERED);
+    // Subscribed commands are processed
+    RX_OK(LCSF_TranscoderReceive(sc2_msg, sizeof(sc2_msg)));
+    test_buffer(TEST_ID_SC1, txbuffer);
+    // Other protocols are not filtered
+    expect_senderr_cb(err_unknown_prot_msg, sizeof(err_unknown_prot_msg));
+    CHECK(LCSF_TranscoderReceive(bad_prot_id_msg, sizeof(bad_prot_id_msg)) == LCSF_RECEIVE_UNKNOWN_PROT_ID);
+}
+
+/**
+ * testgroup: A_Test_Fullstack
+ * testname: prepare
+ *
+ * Test the prepared command data rewrite against a full encoding
+ */
+TEST(A_Test_Fullstack, prepare) {
+    uint8_t prepBuffer[TX_BUFF_SIZE];
+    uint8_t refBuffer[TX_BUFF_SIZE];
+    lcsf_prepared_att_t prepAttArray[ARRAY_SIZE];
+    lcsf_prepared_cmd_t prepared;
+    uint8_t sa1 = 0x12;
+    uint16_t sa2 = 0x3456;
+    uint8_t values[2 * sizeof(sa1) + sizeof(sa2)];
+    lcsf_valid_att_t ca1AttArray[LCSF_TEST_ATT_CA1_SUBATT_NB] = {
+        {sizeof(sa1), {&sa1}},
+        {sizeof(sa2), {&sa2}},
+        {0, {NULL}},
+    };
+    lcsf_valid_att_t attArray[LCSF_TEST_CMD_CC4_ATT_NB] = {
+        {sizeof(sa1), {&sa1}},
+        {0, {.pSubAttArray = ca1AttArray}},
+        {0, {NULL}},
+    };
+    lcsf_valid_cmd_t cmd = {LCSF_TEST_CMD_ID_CC4, attArray};
+    const uint16_t protId = LCSF_TEST_PROTOCOL_ID;
+
+    // Test error cases
+    CHECK_FALSE(LCSF_ValidatorPrepare(protId, NULL, prepBuffer, TX_BUFF_SIZE, prepAttArray, ARRAY_SIZE, &prepared));
+    CHECK_FALSE(LCSF_ValidatorPrepare(protId, &cmd, prepBuffer, TX_BUFF_SIZE, prepAttArray, 3, &prepared));
+    CHECK_FALSE(LCSF_ValidatorPrepare(protId, &cmd, prepBuffer, 8, prepAttArray, ARRAY_SIZE, &prepared));
+    CHECK_EQUAL(LCSF_ValidatorExecute(NULL, values, sizeof(values)), -1);
+    // Test prepare
+    CHECK(LCSF_ValidatorPrepare(protId, &cmd, prepBuffer, TX_BUFF_SIZE, prepAttArray, ARRAY_SIZE, &prepared));
+    CHECK_EQUAL(prepared.AttNb, 4);
+    int refSize = LCSF_ValidatorEncode(protId, &cmd, refBuffer, TX_BUFF_SIZE);
+    CHECK_EQUAL(prepared.MsgSize, refSize);
+    MEMCMP_EQUAL(refBuffer, prepBuffer, refSize);
+    CHECK_EQUAL(prepared.ValuesSize, sizeof(values));
+    // Test execute with new values, in the prepared attribute order
+    sa1 = 0x21;
+    sa2 = 0x6543;
+    values[0] = sa1;
+    values[1] = sa1;
+    memcpy(&values[2], &sa2, sizeof(sa2));
+    CHECK_EQUAL(LCSF_ValidatorExecute(&prepared, values, sizeof(values)), refSize);
+    CHECK_EQUAL(LCSF_ValidatorEncode(protId, &cmd, refBuffer, TX_BUFF_SIZE), refSize);
+    MEMCMP_EQUAL(refBuffer, prepBuffer, refSize);
+    // Test values layout changes, the message is left unchanged
+    values[0] = 0x33;
+    CHECK_EQUAL(LCSF_ValidatorExecute(&prepared, values, sizeof(values) - 1), -1);
+    CHECK_EQUAL(LCSF_ValidatorExecute(&prepared, NULL, sizeof(values)), -1);
+    MEMCMP_EQUAL(refBuffer, prepBuffer, refSize);
+    // Test copies of the prepared message, the prepared one is left unchanged
+    uint8_t copyBuffer[TX_BUFF_SIZE];
+    sa1 = 0x44;
+    values[0] = sa1;
+    values[1] = sa1;
+    CHECK_EQUAL(LCSF_ValidatorExecuteCopy(&prepared, values, sizeof(values), NULL, TX_BUFF_SIZE), -1);
+    CHECK_EQUAL(LCSF_ValidatorExecuteCopy(&prepared, values, sizeof(values) - 1, copyBuffer, TX_BUFF_SIZE), -1);
+    CHECK_EQUAL(LCSF_ValidatorExecuteCopy(&prepared, values, sizeof(values), copyBuffer, refSize - 1), -1);
+    CHECK_EQUAL(LCSF_ValidatorExecuteCopy(&prepared, values, sizeof(values), copyBuffer, TX_BUFF_SIZE), refSize);
+    MEMCMP_EQUAL(refBuffer, prepBuffer, refSize);
+    CHECK_EQUAL(LCSF_ValidatorEncode(protId, &cmd, refBuffer, TX_BUFF_SIZE), refSize);
+    MEMCMP_EQUAL(refBuffer, copyBuffer, refSize);
+    // Test a constant template, without values
+    cmd.CmdId = LCSF_TEST_CMD_ID_SC1;
+    CHECK(LCSF_ValidatorPrepare(protId, &cmd, prepBuffer, TX_BUFF_SIZE, prepAttArray, ARRAY_SIZE, &prepared));
+    CHECK_EQUAL(prepared.ValuesSize, 0);
+    CHECK_EQUAL(LCSF_ValidatorExecuteCopy(&prepared, NULL, 0, copyBuffer, TX_BUFF_SIZE), sizeof(sc1_msg));
+    MEMCMP_EQUAL(sc1_msg, copyBuffer, sizeof(sc1_msg));
+}
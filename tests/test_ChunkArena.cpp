@@ -0,0 +1,136 @@
+/**
+ * @file test_ChunkArena.cpp
+ * @brief Unit test of the ChunkArena module
+ * @author Jean-Roland Gosse
+ *
+ * This file is part of LCSF C Stack.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ */
+
+// *** Private include ***
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+extern "C" {
+#include "LCSF_Config.h"
+#include "Lifo.h"
+#include "ChunkArena.h"
+}
+
+// *** Private macros ***
+#define CHUNK_SIZE 64
+
+// *** Private variables ***
+static chunk_arena_t TestArena;
+static lifo_allocator_t TestAllocator;
+
+// *** Public functions ***
+
+/**
+ * testgroup: chunk_arena
+ *
+ * This group tests all the chunk arena features
+ */
+TEST_GROUP(chunk_arena) {
+    void setup() {
+        CHECK(ChunkArenaInit(&TestArena, CHUNK_SIZE, &TestAllocator));
+    }
+
+    void teardown() {
+        ChunkArenaRelease(&TestArena);
+    }
+};
+
+/**
+ * testgroup: chunk_arena
+ * testname: get_free
+ *
+ * Test the arena allocation, growth and recycling
+ */
+TEST(chunk_arena, get_free) {
+    uint8_t *pData1, *pData2, *pData3, *pData4;
+
+    // Bad parameters
+    CHECK_FALSE(ChunkArenaInit(NULL, CHUNK_SIZE, NULL));
+    CHECK_FALSE(ChunkArenaInit(&TestArena, 0, NULL));
+    CHECK(ChunkArenaGet(NULL, 1) == NULL);
+
+    // Allocations are aligned and contiguous in a chunk
+    pData1 = (uint8_t *)ChunkArenaGet(&TestArena, 3);
+    pData2 = (uint8_t *)ChunkArenaGet(&TestArena, CHUNK_SIZE - 8);
+    CHECK(pData1 != NULL);
+    CHECK_EQUAL((uintptr_t)(pData1 + 8), (uintptr_t)pData2);
+    memset(pData2, 0xAA, CHUNK_SIZE - 8);
+
+    // Arena grows with a new chunk, oversized allocations get their own chunk
+    pData3 = (uint8_t *)ChunkArenaGet(&TestArena, 1);
+    CHECK(pData3 != NULL);
+    CHECK((pData3 < pData1) || (pData3 >= pData1 + CHUNK_SIZE));
+    pData4 = (uint8_t *)ChunkArenaGet(&TestArena, 4 * CHUNK_SIZE);
+    CHECK(pData4 != NULL);
+    memset(pData4, 0x55, 4 * CHUNK_SIZE);
+
+    // Free all recycles the chunks
+    ChunkArenaFreeAll(&TestArena);
+    CHECK_EQUAL((uintptr_t)pData1, (uintptr_t)ChunkArenaGet(&TestArena, CHUNK_SIZE));
+    CHECK_EQUAL((uintptr_t)pData3, (uintptr_t)ChunkArenaGet(&TestArena, CHUNK_SIZE));
+    CHECK_EQUAL((uintptr_t)pData4, (uintptr_t)ChunkArenaGet(&TestArena, 2 * CHUNK_SIZE));
+}
+
+/**
+ * testgroup: chunk_arena
+ * testname: lifo_allocator
+ *
+ * Test the arena as a lifo allocator
+ */
+TEST(chunk_arena, lifo_allocator) {
+    lifo_desc_t lifo;
+    void *pData1, *pData2;
+
+    // Bad parameters
+    CHECK_FALSE(LifoInitAllocator(NULL, &TestAllocator, sizeof(uint32_t)));
+    CHECK_FALSE(LifoInitAllocator(&lifo, NULL, sizeof(uint32_t)));
+    CHECK_FALSE(LifoInitAllocator(&lifo, &TestAllocator, 0));
+
+    // Lifo is not limited by a fixed buffer
+    CHECK(LifoInitAllocator(&lifo, &TestAllocator, sizeof(uint32_t)));
+    CHECK(LifoGet(&lifo, 2, &pData1));
+    CHECK(LifoGet(&lifo, 10 * CHUNK_SIZE, &pData2));
+    CHECK(pData1 != NULL);
+    CHECK(pData2 != NULL);
+    memset(pData2, 0x55, 10 * CHUNK_SIZE * sizeof(uint32_t));
+    CHECK_FALSE(LifoGet(&lifo, UINT16_MAX, &pData2));
+    CHECK(pData2 == NULL);
+
+    // Memory is recycled once the lifo is empty
+    CHECK(LifoFree(&lifo, 1));
+    CHECK(LifoGet(&lifo, 1, &pData2));
+    CHECK(pData2 != NULL);
+    CHECK(LifoFreeAll(&lifo));
+    CHECK(LifoGet(&lifo, 2, &pData2));
+    CHECK_EQUAL((uintptr_t)pData1, (uintptr_t)pData2);
+    CHECK(LifoFree(&lifo, 2));
+    CHECK(LifoGet(&lifo, 2, &pData2));
+    CHECK_EQUAL((uintptr_t)pData1, (uintptr_t)pData2);
+
+    // Regions stacked on an allocator lifo
+    lifo_desc_t region;
+    CHECK(LifoFreeAll(&lifo));
+    CHECK(LifoInitRegion(&region, &lifo, sizeof(uint64_t)));
+    CHECK(LifoGet(&region, 3, &pData2));
+    CHECK_EQUAL((uintptr_t)pData1, (uintptr_t)pData2);
+    CHECK(LifoFreeAll(&region));
+    CHECK_EQUAL(lifo.FreeItemNb, lifo.ItemNb);
+}
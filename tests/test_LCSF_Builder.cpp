@@ -0,0 +1,133 @@
+/**
+ * @file test_LCSF_Builder.cpp
+ * @brief Unit test of the LCSF_Builder module
+ * @author Jean-Roland Gosse
+ *
+ * This file is part of LCSF C Stack.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ */
+
+// *** Private include ***
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+extern "C" {
+#include "LCSF_Config.h"
+#include "LCSF_Transcoder.h"
+#include "LCSF_Builder.h"
+#include <string.h>
+}
+
+// *** Private macros ***
+#define BUFF_SIZE 64
+
+// *** Private variables ***
+static uint8_t refBuffer[BUFF_SIZE];
+static uint8_t msgBuffer[BUFF_SIZE];
+
+// Test data
+static uint16_t att1Value = 0x1234;
+static uint8_t att2Value = 0xa;
+static uint32_t att3Value = 0x200;
+static char att4String[] = "Organoleptic";
+
+static lcsf_raw_att_t subSubAttArr[] = {
+    {0x33, false, 2, {(uint8_t *)&att3Value}},
+};
+
+static lcsf_raw_att_t subAttArr[] = {
+    {0x30, false, sizeof(att2Value), {&att2Value}},
+    {0x32, true, 1, {.pSubAttArray = subSubAttArr}},
+};
+
+static lcsf_raw_att_t attArr[] = {
+    {0x05, false, sizeof(att1Value), {(uint8_t *)&att1Value}},
+    {0x31, true, 2, {.pSubAttArray = subAttArr}},
+    {0x40, false, sizeof(att4String), {(uint8_t *)att4String}},
+};
+
+static const lcsf_raw_msg_t msg = {0xab, 0x01, 0x12, 3, attArr};
+
+// *** Tests ***
+
+/**
+ * testgroup: LCSF_Builder
+ *
+ * This group tests all the LCSF_Builder features
+ */
+TEST_GROUP(LCSF_Builder){};
+
+/**
+ * testgroup: LCSF_Builder
+ * testname: build
+ *
+ * Test building a message in both representations against the transcoder encoding
+ */
+TEST(LCSF_Builder, build) {
+    const lcsf_repr_t reprArray[] = {LCSF_REPR_STANDARD, LCSF_REPR_SMALL};
+    lcsf_builder_t builder;
+
+    for (size_t reprIdx = 0; reprIdx < sizeof(reprArray) / sizeof(lcsf_repr_t); reprIdx++) {
+        lcsf_repr_t repr = reprArray[reprIdx];
+        int refSize = LCSF_TranscoderEncodeRepr(&msg, refBuffer, BUFF_SIZE, repr);
+        CHECK(refSize > 0);
+        // Test error cases
+        CHECK_FALSE(LCSF_BuilderBeginMsg(NULL, msgBuffer, BUFF_SIZE, repr, 0xab, 0x01, 0x12));
+        CHECK_FALSE(LCSF_BuilderBeginMsg(&builder, msgBuffer, 3, repr, 0xab, 0x01, 0x12));
+        CHECK_FALSE(LCSF_BuilderAddU8(&builder, 0x01, 0x00));
+        CHECK_EQUAL(LCSF_BuilderEndMsg(&builder), -1);
+        // Test valid message
+        CHECK(LCSF_BuilderBeginMsg(&builder, msgBuffer, BUFF_SIZE, repr, 0xab, 0x01, 0x12));
+        CHECK(LCSF_BuilderAddU16(&builder, 0x05, att1Value));
+        CHECK(LCSF_BuilderBeginGroup(&builder, 0x31));
+        CHECK(LCSF_BuilderAddU8(&builder, 0x30, att2Value));
+        CHECK(LCSF_BuilderBeginGroup(&builder, 0x32));
+        CHECK(LCSF_BuilderAddVle(&builder, 0x33, att3Value));
+        CHECK_EQUAL(LCSF_BuilderEndMsg(&builder), -1);
+        CHECK(LCSF_BuilderEndGroup(&builder));
+        CHECK(LCSF_BuilderEndGroup(&builder));
+        CHECK(LCSF_BuilderAddString(&builder, 0x40, att4String));
+        CHECK_FALSE(LCSF_BuilderEndGroup(&builder));
+        CHECK(builder.HasError);
+        // Failed operation invalidates the message
+        CHECK_EQUAL(LCSF_BuilderEndMsg(&builder), -1);
+        CHECK(LCSF_BuilderBeginMsg(&builder, msgBuffer, BUFF_SIZE, repr, 0xab, 0x01, 0x12));
+        CHECK(LCSF_BuilderAddU16(&builder, 0x05, att1Value));
+        CHECK(LCSF_BuilderBeginGroup(&builder, 0x31));
+        CHECK(LCSF_BuilderAddU8(&builder, 0x30, att2Value));
+        CHECK(LCSF_BuilderBeginGroup(&builder, 0x32));
+        CHECK(LCSF_BuilderAddVle(&builder, 0x33, att3Value));
+        CHECK(LCSF_BuilderEndGroup(&builder));
+        CHECK(LCSF_BuilderEndGroup(&builder));
+        CHECK(LCSF_BuilderAddString(&builder, 0x40, att4String));
+        CHECK_EQUAL(LCSF_BuilderEndMsg(&builder), refSize);
+        MEMCMP_EQUAL(refBuffer, msgBuffer, refSize);
+        // Test buffer overflow
+        CHECK(LCSF_BuilderBeginMsg(&builder, msgBuffer, refSize - 1, repr, 0xab, 0x01, 0x12));
+        CHECK(LCSF_BuilderAddU16(&builder, 0x05, att1Value));
+        CHECK(LCSF_BuilderBeginGroup(&builder, 0x31));
+        CHECK(LCSF_BuilderAddU8(&builder, 0x30, att2Value));
+        CHECK(LCSF_BuilderBeginGroup(&builder, 0x32));
+        CHECK(LCSF_BuilderAddVle(&builder, 0x33, att3Value));
+        CHECK(LCSF_BuilderEndGroup(&builder));
+        CHECK(LCSF_BuilderEndGroup(&builder));
+        CHECK_FALSE(LCSF_BuilderAddString(&builder, 0x40, att4String));
+        CHECK_EQUAL(LCSF_BuilderEndMsg(&builder), -1);
+    }
+    // Test smaller representation limits
+    CHECK_FALSE(LCSF_BuilderBeginMsg(&builder, msgBuffer, BUFF_SIZE, LCSF_REPR_SMALL, 0xab, 0x01, 0x1200));
+    CHECK(LCSF_BuilderBeginMsg(&builder, msgBuffer, BUFF_SIZE, LCSF_REPR_SMALL, 0xab, 0x01, 0x12));
+    CHECK_FALSE(LCSF_BuilderAddU8(&builder, 0x80, 0x00));
+}
@@ -0,0 +1,190 @@
+/**
+ * @file test_LCSF_Cursor.cpp
+ * @brief Unit test of the LCSF_Cursor module
+ * @author Jean-Roland Gosse
+ *
+ * This file is part of LCSF C Stack.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ */
+
+// *** Private include ***
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+extern "C" {
+#include "LCSF_Config.h"
+#include "LCSF_Transcoder.h"
+#include "LCSF_Cursor.h"
+}
+
+// *** Private macros ***
+#define BUFF_SIZE 64
+
+// *** Private variables ***
+static uint8_t msgBuffer[BUFF_SIZE];
+
+// Test data
+static uint8_t att1Data[] = {0x00, 0x01, 0x02, 0x03, 0x04};
+static uint8_t att2Data[] = {0xa};
+static uint8_t att3Data[] = {0xab, 0xcd};
+static uint8_t att4Data[] = {0x12, 0x34, 0x56};
+
+static lcsf_raw_att_t subSubAttArr[] = {
+    {0x33, false, sizeof(att3Data), {att3Data}},
+};
+
+static lcsf_raw_att_t subAttArr[] = {
+    {0x30, false, sizeof(att2Data), {att2Data}},
+    {0x32, true, 1, {.pSubAttArray = subSubAttArr}},
+};
+
+static lcsf_raw_att_t attArr[] = {
+    {0x05, false, sizeof(att1Data), {att1Data}},
+    {0x31, true, 2, {.pSubAttArray = subAttArr}},
+    {0x40, false, sizeof(att4Data), {att4Data}},
+};
+
+static const lcsf_raw_msg_t msg = {0xab, 0x01, 0x12, 3, attArr};
+
+// *** Tests ***
+
+/**
+ * testgroup: LCSF_Cursor
+ *
+ * This group tests all the LCSF_Cursor features
+ */
+TEST_GROUP(LCSF_Cursor){};
+
+/**
+ * testgroup: LCSF_Cursor
+ * testname: walk
+ *
+ * Test walking through the attributes in both representations
+ */
+TEST(LCSF_Cursor, walk) {
+    const lcsf_repr_t reprArray[] = {LCSF_REPR_STANDARD, LCSF_REPR_SMALL};
+    lcsf_cursor_t cursor;
+    lcsf_raw_msg_t header;
+    lcsf_raw_att_t att;
+
+    for (size_t reprIdx = 0; reprIdx < sizeof(reprArray) / sizeof(lcsf_repr_t); reprIdx++) {
+        lcsf_repr_t repr = reprArray[reprIdx];
+        int msgSize = LCSF_TranscoderEncodeRepr(&msg, msgBuffer, BUFF_SIZE, repr);
+        CHECK(msgSize > 0);
+        // Test error cases
+        CHECK_FALSE(LCSF_CursorInit(NULL, msgBuffer, msgSize, repr, NULL));
+        CHECK_FALSE(LCSF_CursorInit(&cursor, NULL, msgSize, repr, NULL));
+        CHECK_FALSE(LCSF_CursorInit(&cursor, msgBuffer, 3, repr, NULL));
+        // Test header
+        CHECK(LCSF_CursorInit(&cursor, msgBuffer, msgSize, repr, &header));
+        CHECK_EQUAL(header.ProtId, msg.ProtId);
+        CHECK_EQUAL(header.ProtVer, msg.ProtVer);
+        CHECK_EQUAL(header.CmdId, msg.CmdId);
+        CHECK_EQUAL(header.AttNb, msg.AttNb);
+        // Test full walk, last sub-attribute level not entered
+        CHECK_FALSE(LCSF_CursorLeave(&cursor));
+        CHECK(LCSF_CursorNext(&cursor, &att));
+        CHECK_EQUAL(att.AttId, 0x05);
+        CHECK_FALSE(att.HasSubAtt);
+        CHECK_EQUAL(att.PayloadSize, sizeof(att1Data));
+        MEMCMP_EQUAL(att1Data, att.Payload.pData, sizeof(att1Data));
+        CHECK_FALSE(LCSF_CursorEnter(&cursor));
+        CHECK(LCSF_CursorNext(&cursor, &att));
+        CHECK_EQUAL(att.AttId, 0x31);
+        CHECK(att.HasSubAtt);
+        CHECK_EQUAL(att.PayloadSize, 2);
+        CHECK(LCSF_CursorEnter(&cursor));
+        CHECK(LCSF_CursorNext(&cursor, &att));
+        CHECK_EQUAL(att.AttId, 0x30);
+        MEMCMP_EQUAL(att2Data, att.Payload.pData, sizeof(att2Data));
+        CHECK(LCSF_CursorNext(&cursor, &att));
+        CHECK_EQUAL(att.AttId, 0x32);
+        CHECK_FALSE(LCSF_CursorNext(&cursor, &att));
+        CHECK(LCSF_CursorLeave(&cursor));
+        CHECK(LCSF_CursorNext(&cursor, &att));
+        CHECK_EQUAL(att.AttId, 0x40);
+        MEMCMP_EQUAL(att4Data, att.Payload.pData, sizeof(att4Data));
+        CHECK_FALSE(LCSF_CursorNext(&cursor, &att));
+        CHECK_FALSE(cursor.HasError);
+        // Test leaving a level early
+        CHECK(LCSF_CursorInit(&cursor, msgBuffer, msgSize, repr, NULL));
+        CHECK(LCSF_CursorNext(&cursor, &att));
+        CHECK(LCSF_CursorNext(&cursor, &att));
+        CHECK(LCSF_CursorEnter(&cursor));
+        CHECK(LCSF_CursorNext(&cursor, &att));
+        CHECK(LCSF_CursorNext(&cursor, &att));
+        CHECK(LCSF_CursorEnter(&cursor));
+        CHECK(LCSF_CursorLeave(&cursor));
+        CHECK(LCSF_CursorLeave(&cursor));
+        CHECK(LCSF_CursorNext(&cursor, &att));
+        CHECK_EQUAL(att.AttId, 0x40);
+        // Test truncated message
+        CHECK(LCSF_CursorInit(&cursor, msgBuffer, msgSize - 1, repr, NULL));
+        CHECK(LCSF_CursorNext(&cursor, &att));
+        CHECK(LCSF_CursorNext(&cursor, &att));
+        CHECK_FALSE(LCSF_CursorNext(&cursor, &att));
+        CHECK(cursor.HasError);
+    }
+}
+
+/**
+ * testgroup: LCSF_Cursor
+ * testname: decode_flat
+ *
+ * Test decoding the attributes into a preorder node array in both representations
+ */
+TEST(LCSF_Cursor, decode_flat) {
+    const lcsf_repr_t reprArray[] = {LCSF_REPR_STANDARD, LCSF_REPR_SMALL};
+    // Expected nodes: id, flag, payload size, data or index of the next sibling
+    const lcsf_flat_node_t refNodeArray[] = {
+        {0x05, false, sizeof(att1Data), 0},
+        {0x31, true, 2, 5},
+        {0x30, false, sizeof(att2Data), 0},
+        {0x32, true, 1, 5},
+        {0x33, false, sizeof(att3Data), 0},
+        {0x40, false, sizeof(att4Data), 0},
+    };
+    const uint8_t *refDataArray[] = {att1Data, NULL, att2Data, NULL, att3Data, att4Data};
+    const size_t refNodeNb = sizeof(refNodeArray) / sizeof(lcsf_flat_node_t);
+    lcsf_flat_node_t nodeArray[8];
+    lcsf_raw_msg_t header;
+    size_t nodeNb;
+
+    for (size_t reprIdx = 0; reprIdx < sizeof(reprArray) / sizeof(lcsf_repr_t); reprIdx++) {
+        lcsf_repr_t repr = reprArray[reprIdx];
+        int msgSize = LCSF_TranscoderEncodeRepr(&msg, msgBuffer, BUFF_SIZE, repr);
+        CHECK(msgSize > 0);
+        // Test error cases
+        CHECK_FALSE(LCSF_CursorDecodeFlat(msgBuffer, msgSize, repr, NULL, NULL, 8, &nodeNb));
+        CHECK_FALSE(LCSF_CursorDecodeFlat(msgBuffer, msgSize, repr, NULL, nodeArray, refNodeNb - 1, &nodeNb));
+        CHECK_FALSE(LCSF_CursorDecodeFlat(msgBuffer, msgSize - 1, repr, NULL, nodeArray, 8, &nodeNb));
+        // Trailing bytes after the last attribute
+        CHECK_FALSE(LCSF_CursorDecodeFlat(msgBuffer, msgSize + 1, repr, NULL, nodeArray, 8, &nodeNb));
+        // Test valid message
+        CHECK(LCSF_CursorDecodeFlat(msgBuffer, msgSize, repr, &header, nodeArray, 8, &nodeNb));
+        CHECK_EQUAL(header.AttNb, msg.AttNb);
+        CHECK_EQUAL(refNodeNb, nodeNb);
+        for (size_t idx = 0; idx < refNodeNb; idx++) {
+            CHECK_EQUAL(refNodeArray[idx].AttId, nodeArray[idx].AttId);
+            CHECK_EQUAL(refNodeArray[idx].HasSubAtt, nodeArray[idx].HasSubAtt);
+            CHECK_EQUAL(refNodeArray[idx].PayloadSize, nodeArray[idx].PayloadSize);
+            if (nodeArray[idx].HasSubAtt) {
+                CHECK_EQUAL(refNodeArray[idx].Offset, nodeArray[idx].Offset);
+            } else {
+                MEMCMP_EQUAL(refDataArray[idx], &msgBuffer[nodeArray[idx].Offset], nodeArray[idx].PayloadSize);
+            }
+        }
+    }
+}
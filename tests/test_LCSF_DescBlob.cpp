@@ -0,0 +1,135 @@
+/**
+ * @file test_LCSF_DescBlob.cpp
+ * @brief Unit test of the LCSF_DescBlob module
+ * @author Jean-Roland Gosse
+ *
+ * This file is part of LCSF C Stack.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ */
+
+// *** Private include ***
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+extern "C" {
+#include <string.h>
+#include "LCSF_Config.h"
+#include "LCSF_Validator.h"
+#include "LCSF_DescBlob.h"
+#include "LCSF_Bridge_Example.h"
+}
+
+// *** Private macros ***
+#define BLOB_SIZE 128
+#define BLOB_PROTOCOL_ID (LCSF_EXAMPLE_PROTOCOL_ID + 3)
+
+// *** Private variables ***
+static uint16_t blobBuffer[BLOB_SIZE / sizeof(uint16_t)]; // Aligned as a mapped file
+static uint8_t errCode = 0x04;
+
+static lcsf_raw_att_t errAttArr[] = {
+    {LCSF_EXAMPLE_ATT_ERROR_CODE, false, sizeof(errCode), {.pData = &errCode}},
+};
+
+static const lcsf_raw_msg_t errCmdMsg = {
+    BLOB_PROTOCOL_ID,
+    LCSF_EXAMPLE_PROTOCOL_VERSION,
+    LCSF_EXAMPLE_CMD_ID_ERROR,
+    1,
+    errAttArr,
+};
+
+// *** Private functions ***
+
+static bool blob_interpret_callback(lcsf_valid_cmd_t *pValidCmd) {
+    mock().actualCall("blob_interpret_callback");
+    return (pValidCmd->CmdId == LCSF_EXAMPLE_CMD_ID_ERROR) &&
+        (*(uint8_t *)pValidCmd->pAttArray[0].Payload.pData == errCode);
+}
+
+static bool senderr_callback(const uint8_t *pBuffer, size_t buffSize) {
+    (void)pBuffer;
+    (void)buffSize;
+    return true;
+}
+
+static void recerr_callback(uint_fast8_t errorLoc, uint_fast8_t errorType) {
+    (void)errorLoc;
+    (void)errorType;
+}
+
+// *** Tests ***
+
+/**
+ * testgroup: LCSF_DescBlob
+ *
+ * This group tests all the LCSF_DescBlob features
+ */
+TEST_GROUP(LCSF_DescBlob) {
+    void setup() {
+        CHECK(LCSF_ValidatorInit(&senderr_callback, &recerr_callback));
+    }
+    void teardown() {
+        mock().checkExpectations();
+        mock().clear();
+    }
+};
+
+/**
+ * testgroup: LCSF_DescBlob
+ * testname: load
+ *
+ * Test writing a blob then receiving a message with the protocol loaded in place
+ */
+TEST(LCSF_DescBlob, load) {
+    lcsf_packed_cmd_desc_t cmdArray[LCSF_EXAMPLE_CMD_NB];
+    lcsf_packed_att_desc_t attArray[16];
+    lcsf_packed_prot_desc_t packedDesc;
+    lcsf_blob_prot_t blobProt;
+    uint8_t *pBlob = (uint8_t *)blobBuffer;
+
+    CHECK(LCSF_ValidatorPackDesc(&LCSF_Example_ProtDesc, cmdArray, LCSF_EXAMPLE_CMD_NB, attArray, 16, &packedDesc));
+    // Test write
+    CHECK_EQUAL(-1, LCSF_DescBlobWrite(BLOB_PROTOCOL_ID, LCSF_EXAMPLE_PROTOCOL_VERSION, NULL, pBlob, BLOB_SIZE));
+    CHECK_EQUAL(-1, LCSF_DescBlobWrite(BLOB_PROTOCOL_ID, LCSF_EXAMPLE_PROTOCOL_VERSION, &packedDesc, pBlob, 16));
+    int blobSize = LCSF_DescBlobWrite(BLOB_PROTOCOL_ID, LCSF_EXAMPLE_PROTOCOL_VERSION, &packedDesc, pBlob, BLOB_SIZE);
+    CHECK_EQUAL(sizeof(lcsf_blob_header_t) + (LCSF_EXAMPLE_CMD_NB + 10) * 6, blobSize);
+    // Test load error cases
+    CHECK_FALSE(LCSF_DescBlobLoad(NULL, blobSize, blob_interpret_callback, &blobProt));
+    CHECK_FALSE(LCSF_DescBlobLoad(pBlob, blobSize - 1, blob_interpret_callback, &blobProt));
+    CHECK_FALSE(LCSF_DescBlobLoad(pBlob, blobSize, NULL, &blobProt));
+    pBlob[0] = 'X';
+    CHECK_FALSE(LCSF_DescBlobLoad(pBlob, blobSize, blob_interpret_callback, &blobProt));
+    pBlob[0] = 'L';
+    ((lcsf_blob_header_t *)pBlob)->Reserved = 1;
+    CHECK_FALSE(LCSF_DescBlobLoad(pBlob, blobSize, blob_interpret_callback, &blobProt));
+    ((lcsf_blob_header_t *)pBlob)->Reserved = 0;
+    // Sub-attribute level looping on its parent record
+    lcsf_packed_att_desc_t *pBlobAttArray =
+        (lcsf_packed_att_desc_t *)&(pBlob[sizeof(lcsf_blob_header_t) + LCSF_EXAMPLE_CMD_NB * 6]);
+    size_t groupIdx = 0;
+    while (pBlobAttArray[groupIdx].SubAttNb == 0) {
+        groupIdx++;
+    }
+    uint16_t subAttIdx = pBlobAttArray[groupIdx].SubAttIdx;
+    pBlobAttArray[groupIdx].SubAttIdx = (uint16_t)groupIdx;
+    CHECK_FALSE(LCSF_DescBlobLoad(pBlob, blobSize, blob_interpret_callback, &blobProt));
+    pBlobAttArray[groupIdx].SubAttIdx = subAttIdx;
+    // Test loading and receiving
+    CHECK(LCSF_DescBlobAddProtocol(1, pBlob, blobSize, blob_interpret_callback, &blobProt));
+    CHECK(blobProt.PackedDesc.pAttArray == pBlobAttArray);
+    mock().expectOneCall("blob_interpret_callback");
+    CHECK(LCSF_ValidatorReceive(&errCmdMsg) == LCSF_RECEIVE_OK);
+}
@@ -0,0 +1,164 @@
+/**
+ * @file test_LCSF_RxRing.cpp
+ * @brief Unit test of the LCSF_RxRing module
+ * @author Jean-Roland Gosse
+ *
+ * This file is part of LCSF C Stack.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ */
+
+// *** Private include ***
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+extern "C" {
+#include <string.h>
+#include "LCSF_Config.h"
+#include "LCSF_Builder.h"
+#include "LCSF_Validator.h"
+#include "LCSF_RxRing.h"
+#include "LCSF_Bridge_Test.h"
+}
+
+// *** Private macros ***
+#define SLOT_SIZE 16
+#define SLOT_NB 2
+
+// *** Private variables ***
+static uint8_t ringData[SLOT_SIZE * SLOT_NB];
+static lcsf_rx_slot_t slotArray[SLOT_NB];
+static lcsf_rx_ring_t ring;
+static lcsf_rx_lease_t deferredLease;
+static lcsf_rx_lease_t extraLease;
+static bool isExtraLease;
+
+// *** Private functions ***
+
+static bool ring_interpret_callback(lcsf_valid_cmd_t *pValidCmd) {
+    mock().actualCall("ring_interpret_callback");
+    // Keep the frame to process it later
+    if (isExtraLease && !LCSF_RxRingRetain(&ring, &extraLease)) {
+        return false;
+    }
+    return (pValidCmd->CmdId == LCSF_TEST_CMD_ID_SC1) && LCSF_RxRingRetain(&ring, &deferredLease);
+}
+
+static const lcsf_validator_protocol_desc_t ring_prot_desc = {
+    LCSF_TEST_PROTOCOL_ID,
+    LCSF_TEST_PROTOCOL_VERSION,
+    LCSF_Test_ProtDesc.pProtDesc,
+    ring_interpret_callback,
+    false,
+    NULL,
+    NULL,
+};
+
+static bool senderr_callback(const uint8_t *pBuffer, size_t buffSize) {
+    (void)pBuffer;
+    (void)buffSize;
+    return true;
+}
+
+static void fill_frame(void) {
+    lcsf_builder_t builder;
+    uint8_t *pBuffer = LCSF_RxRingGetFillBuffer(&ring);
+    CHECK(pBuffer != NULL);
+    CHECK(LCSF_BuilderBeginMsg(&builder, pBuffer, SLOT_SIZE, LCSF_REPR_DEFAULT, LCSF_TEST_PROTOCOL_ID,
+        LCSF_TEST_PROTOCOL_VERSION, LCSF_TEST_CMD_ID_SC1));
+    int frameSize = LCSF_BuilderEndMsg(&builder);
+    CHECK(frameSize > 0);
+    CHECK(LCSF_RxRingCommit(&ring, (size_t)frameSize));
+}
+
+// *** Tests ***
+
+/**
+ * testgroup: LCSF_RxRing
+ *
+ * This group tests all the LCSF_RxRing features
+ */
+TEST_GROUP(LCSF_RxRing) {
+    void setup() {
+        CHECK(LCSF_TranscoderInit());
+        CHECK(LCSF_ValidatorInit(&senderr_callback, NULL));
+        CHECK(LCSF_ValidatorAddProtocol(0, &ring_prot_desc));
+        CHECK(LCSF_RxRingInit(&ring, ringData, SLOT_SIZE, slotArray, SLOT_NB));
+        isExtraLease = false;
+    }
+    void teardown() {
+        mock().checkExpectations();
+        mock().clear();
+    }
+};
+
+/**
+ * testgroup: LCSF_RxRing
+ * testname: lease
+ *
+ * Test filling the next slot while a received frame is leased
+ */
+TEST(LCSF_RxRing, lease) {
+    lcsf_receive_status_t status;
+
+    // Test error cases
+    CHECK_FALSE(LCSF_RxRingInit(&ring, ringData, 0, slotArray, SLOT_NB));
+    CHECK_FALSE(LCSF_RxRingCommit(&ring, SLOT_SIZE + 1));
+    CHECK_FALSE(LCSF_RxRingProcess(&ring, &status));
+    CHECK_FALSE(LCSF_RxRingRetain(&ring, &deferredLease));
+    // Receive a frame and keep it leased
+    fill_frame();
+    mock().expectOneCall("ring_interpret_callback");
+    CHECK(LCSF_RxRingProcess(&ring, &status));
+    CHECK(status == LCSF_RECEIVE_OK);
+    // The other slot is filled meanwhile, then the leased one holds the ring back
+    fill_frame();
+    POINTERS_EQUAL(NULL, LCSF_RxRingGetFillBuffer(&ring));
+    CHECK(LCSF_RxRingRelease(&ring, &deferredLease));
+    CHECK_FALSE(LCSF_RxRingRelease(&ring, &deferredLease));
+    CHECK(LCSF_RxRingGetFillBuffer(&ring) == ringData);
+    // Process the second frame
+    lcsf_rx_lease_t firstLease = deferredLease;
+    mock().expectOneCall("ring_interpret_callback");
+    CHECK(LCSF_RxRingProcess(&ring, &status));
+    CHECK(status == LCSF_RECEIVE_OK);
+    CHECK(LCSF_RxRingRelease(&ring, &deferredLease));
+    CHECK_FALSE(LCSF_RxRingRelease(&ring, &firstLease));
+    CHECK_FALSE(LCSF_RxRingProcess(&ring, &status));
+}
+
+/**
+ * testgroup: LCSF_RxRing
+ * testname: double_release
+ *
+ * Test releasing a lease twice while the frame has other leases
+ */
+TEST(LCSF_RxRing, double_release) {
+    lcsf_receive_status_t status;
+
+    // Receive a frame and keep it with two leases
+    isExtraLease = true;
+    fill_frame();
+    mock().expectOneCall("ring_interpret_callback");
+    CHECK(LCSF_RxRingProcess(&ring, &status));
+    CHECK(status == LCSF_RECEIVE_OK);
+    CHECK(LCSF_RxRingRelease(&ring, &deferredLease));
+    // The second release of the same token must not free the frame still held by the other lease
+    CHECK_FALSE(LCSF_RxRingRelease(&ring, &deferredLease));
+    fill_frame();
+    POINTERS_EQUAL(NULL, LCSF_RxRingGetFillBuffer(&ring));
+    CHECK(LCSF_RxRingRelease(&ring, &extraLease));
+    CHECK_FALSE(LCSF_RxRingRelease(&ring, &extraLease));
+    CHECK(LCSF_RxRingGetFillBuffer(&ring) == ringData);
+}
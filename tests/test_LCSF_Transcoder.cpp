@@ -43,7 +43,7 @@ static uint8_t txBuffer[TX_BUFF_SIZE];
 
 // Test data
 #ifdef LCSF_SMALL
-    static const uint8_t ovrflwMsg[] = {0xaa, 0x01, 0x01, 0x20};
+    static const uint8_t ovrflwMsg[] = {0xaa, 0x01, 0x01, 0x40};
     static const uint8_t badformatMsg[] = {0xaa, 0x01, 0x01, 0x0a};
     static const uint8_t rxMsg[] = {
         0xab, 0x01, // ProtId, ProtVer
@@ -53,7 +53,7 @@ static uint8_t txBuffer[TX_BUFF_SIZE];
         0x65, 0x70, 0x74, 0x69, 0x63, 0x00, 0x00, 0x00, 0x00
     };
 #else
-    static const uint8_t ovrflwMsg[] = {0xaa, 0x00, 0x01, 0x00, 0x01, 0x00, 0x20, 0x00};
+    static const uint8_t ovrflwMsg[] = {0xaa, 0x00, 0x01, 0x00, 0x01, 0x00, 0x40, 0x00};
     static const uint8_t badformatMsg[] = {0xaa, 0x00, 0x01, 0x00, 0x01, 0x00, 0x0a, 0x00};
     static const uint8_t rxMsg[] = {
         0xab, 0x00, 0x01, 0x00, // ProtId, ProtVer
@@ -214,41 +214,123 @@ static bool compare_rawmsg(const lcsf_raw_msg_t *pMsg1, const lcsf_raw_msg_t *pM
  *
  * @param[in]  errorType  The error type
  * @param[in]  isOk       Mock return value
+ * @param[in]  repr       The representation of the error
  */
-static void ExpectSendError(uint_fast8_t errorType, bool isOk) {
-    mock().expectOneCall("LCSF_ValidatorSendTranscoderError").withParameter("errorType", errorType).andReturnValue(isOk);
+static void ExpectSendError(uint_fast8_t errorType, bool isOk, lcsf_repr_t repr = LCSF_REPR_DEFAULT) {
+    mock()
+        .expectOneCall("LCSF_ValidatorSendTranscoderError")
+        .withParameter("errorType", errorType)
+        .withParameter("repr", (int)repr)
+        .andReturnValue(isOk);
 }
 
 /**
- * @brief      Expect a LCSF_ValidatorReceive call helper function
+ * @brief      Expect a LCSF_ValidatorCheckHeader call helper function
+ *
+ * @param[in]  status  Mock return value
  */
-static void ExpectReceive(void) {
-    mock().expectOneCall("LCSF_ValidatorReceive");
+static void ExpectCheckHeader(lcsf_receive_status_t status) {
+    mock().expectOneCall("LCSF_ValidatorCheckHeader").andReturnValue((int)status);
+}
+
+/**
+ * @brief      Expect a route forward callback call helper function
+ *
+ * @param[in]  pBuffer   Pointer to the forwarded buffer
+ * @param[in]  buffSize  The forwarded buffer size
+ * @param[in]  isOk      The return value
+ */
+static void ExpectForward(const uint8_t *pBuffer, size_t buffSize, bool isOk) {
+    mock()
+        .expectOneCall("ForwardCallback")
+        .withPointerParameter("pBuffer", (void *)pBuffer)
+        .withParameter("buffSize", buffSize)
+        .andReturnValue(isOk);
+}
+
+/**
+ * @brief      Expect a LCSF_ValidatorReceiveRepr call helper function
+ *
+ * @param[in]  repr  The representation passed to the call
+ */
+static void ExpectReceive(lcsf_repr_t repr = LCSF_REPR_DEFAULT) {
+    mock().expectOneCall("LCSF_ValidatorReceiveRepr").withParameter("repr", (int)repr);
 }
 
 // *** Mock Functions ***
 
+/**
+ * @brief      mock route forward callback function
+ *
+ * @param[in]  pBuffer   Pointer to the buffer
+ * @param[in]  buffSize  The buffer size
+ *
+ * @return     bool: true if successful
+ */
+static bool ForwardCallback(const uint8_t *pBuffer, size_t buffSize) {
+    mock().actualCall("ForwardCallback").withPointerParameter("pBuffer", (void *)pBuffer).withParameter("buffSize", buffSize);
+    return mock().returnBoolValueOrDefault(false);
+}
+
 /**
  * @brief      mock LCSF_ValidatorSendTranscoderError function
  *
  * @param[in]  errorType  The error type
+ * @param[in]  repr       The representation of the error
  *
  * @return     bool: true if successful
  */
-bool LCSF_ValidatorSendTranscoderError(uint_fast8_t errorType) {
-    mock().actualCall("LCSF_ValidatorSendTranscoderError").withParameter("errorType", errorType);
+bool LCSF_ValidatorSendTranscoderError(uint_fast8_t errorType, lcsf_repr_t repr) {
+    mock().actualCall("LCSF_ValidatorSendTranscoderError").withParameter("errorType", errorType).withParameter("repr", (int)repr);
     return mock().returnBoolValueOrDefault(false);
 }
 
 /**
- * @brief      mock LCSF_ValidatorReceive function
+ * @brief      mock LCSF_ValidatorCheckHeader function
+ *
+ * @param[in]  pMessage  Pointer to the message
+ * @param[in]  repr      The message representation
+ *
+ * @return     lcsf_receive_status_t: mocked status
+ */
+lcsf_receive_status_t LCSF_ValidatorCheckHeader(const lcsf_raw_msg_t *pMessage, lcsf_repr_t repr) {
+    (void)pMessage;
+    (void)repr;
+    mock().actualCall("LCSF_ValidatorCheckHeader");
+    return (lcsf_receive_status_t)mock().returnIntValueOrDefault(LCSF_RECEIVE_OK);
+}
+
+/**
+ * @brief      stub LCSF_ValidatorReceiveFixed function, messages are always left to the generic decoding
  *
  * @param[in]  pMessage  Pointer to the message
+ * @param[in]  pBuffer   Pointer to the encoded attributes
+ * @param[in]  buffSize  The encoded attributes size
+ * @param[in]  repr      The message representation
+ * @param      pStatus   Pointer to the receive status
+ *
+ * @return     bool: false
+ */
+bool LCSF_ValidatorReceiveFixed(const lcsf_raw_msg_t *pMessage, const uint8_t *pBuffer, size_t buffSize,
+    lcsf_repr_t repr, lcsf_receive_status_t *pStatus) {
+    (void)pMessage;
+    (void)pBuffer;
+    (void)buffSize;
+    (void)repr;
+    (void)pStatus;
+    return false;
+}
+
+/**
+ * @brief      mock LCSF_ValidatorReceiveRepr function
+ *
+ * @param[in]  pMessage  Pointer to the message
+ * @param[in]  repr      The message representation
  *
  * @return     bool: true if successful
  */
-lcsf_receive_status_t LCSF_ValidatorReceive(const lcsf_raw_msg_t *pMessage) {
-    mock().actualCall("LCSF_ValidatorReceive");
+lcsf_receive_status_t LCSF_ValidatorReceiveRepr(const lcsf_raw_msg_t *pMessage, lcsf_repr_t repr) {
+    mock().actualCall("LCSF_ValidatorReceiveRepr").withParameter("repr", (int)repr);
     return compare_rawmsg(pMessage, &txMsg) ? LCSF_RECEIVE_OK : LCSF_RECEIVE_ERROR;
 }
 
@@ -302,11 +384,166 @@ TEST(LCSF_Transcoder, encode) {
 TEST(LCSF_Transcoder, receive) {
     // Test error cases
     CHECK(LCSF_TranscoderReceive(NULL, 0) != LCSF_RECEIVE_OK);
+    ExpectCheckHeader(LCSF_RECEIVE_OK);
     ExpectSendError(0x01, true);
     CHECK(LCSF_TranscoderReceive(ovrflwMsg, sizeof(ovrflwMsg)) != LCSF_RECEIVE_OK);
+    ExpectCheckHeader(LCSF_RECEIVE_OK);
     ExpectSendError(0x00, true);
     CHECK(LCSF_TranscoderReceive(badformatMsg, sizeof(badformatMsg)) != LCSF_RECEIVE_OK);
+    // Test well-formed message with too many sub-attributes
+    static uint8_t wideBuffer[256];
+    static lcsf_raw_att_t wideSubAttArr[4 * LCSF_TRANSCODER_RX_LIFO_SIZE];
+    for (uint16_t idx = 0; idx < 4 * LCSF_TRANSCODER_RX_LIFO_SIZE; idx++) {
+        wideSubAttArr[idx].AttId = 0x01;
+        wideSubAttArr[idx].HasSubAtt = false;
+        wideSubAttArr[idx].PayloadSize = 0;
+        wideSubAttArr[idx].Payload.pData = txAtt1Data;
+    }
+    lcsf_raw_att_t wideAtt = {0x02, true, 4 * LCSF_TRANSCODER_RX_LIFO_SIZE, {.pSubAttArray = wideSubAttArr}};
+    const lcsf_raw_msg_t wideMsg = {0xab, 0x01, 0x12, 1, &wideAtt};
+    int wideSize = LCSF_TranscoderEncode(&wideMsg, wideBuffer, sizeof(wideBuffer));
+    CHECK(wideSize > 0);
+    ExpectCheckHeader(LCSF_RECEIVE_OK);
+    ExpectSendError(0x01, true);
+    CHECK(LCSF_TranscoderReceive(wideBuffer, wideSize) == LCSF_RECEIVE_ERROR);
+    // Test rejected header, attributes are not decoded (no overflow error)
+    ExpectCheckHeader(LCSF_RECEIVE_UNKNOWN_PROT_ID);
+    CHECK(LCSF_TranscoderReceive(ovrflwMsg, sizeof(ovrflwMsg)) == LCSF_RECEIVE_UNKNOWN_PROT_ID);
     // Test valid packet
+    ExpectCheckHeader(LCSF_RECEIVE_OK);
     ExpectReceive();
     CHECK(LCSF_TranscoderReceive(rxMsg, sizeof(rxMsg)) == LCSF_RECEIVE_OK);
 }
+
+/**
+ * testgroup: LCSF_Transcoder
+ * testname: route
+ *
+ * Test the routing feature
+ */
+TEST(LCSF_Transcoder, route) {
+    const lcsf_route_t routeArray[] = {
+        {txMsg.ProtId, txMsg.CmdId, false, ForwardCallback},
+        {0xaa, 0x00, true, ForwardCallback},
+    };
+    // Test error cases
+    CHECK_FALSE(LCSF_TranscoderSetRoutes(routeArray, (size_t)UINT16_MAX + 1));
+    // Test routed messages, attributes are not decoded (no overflow error)
+    CHECK(LCSF_TranscoderSetRoutes(routeArray, 2));
+    ExpectForward(rxMsg, sizeof(rxMsg), true);
+    CHECK(LCSF_TranscoderReceive(rxMsg, sizeof(rxMsg)) == LCSF_RECEIVE_FORWARDED);
+    ExpectForward(ovrflwMsg, sizeof(ovrflwMsg), false);
+    CHECK(LCSF_TranscoderReceive(ovrflwMsg, sizeof(ovrflwMsg)) == LCSF_RECEIVE_ERROR);
+    // Test unrouted message, decoded locally
+    CHECK(LCSF_TranscoderSetRoutes(routeArray, 1));
+    ExpectCheckHeader(LCSF_RECEIVE_OK);
+    ExpectSendError(0x01, true);
+    CHECK(LCSF_TranscoderReceive(ovrflwMsg, sizeof(ovrflwMsg)) != LCSF_RECEIVE_OK);
+    // Test routing disabled
+    CHECK(LCSF_TranscoderSetRoutes(NULL, 0));
+    ExpectCheckHeader(LCSF_RECEIVE_OK);
+    ExpectReceive();
+    CHECK(LCSF_TranscoderReceive(rxMsg, sizeof(rxMsg)) == LCSF_RECEIVE_OK);
+}
+
+/**
+ * testgroup: LCSF_Transcoder
+ * testname: repr
+ *
+ * Test the runtime representation selection
+ */
+TEST(LCSF_Transcoder, repr) {
+    int msgSize;
+    // Test error cases
+    CHECK_EQUAL(LCSF_TranscoderEncodeRepr(&txMsg, txBuffer, TX_BUFF_SIZE, (lcsf_repr_t)2), -1);
+    CHECK(LCSF_TranscoderReceiveRepr(rxMsg, sizeof(rxMsg), (lcsf_repr_t)2) == LCSF_RECEIVE_ERROR);
+    // Test standard representation
+    msgSize = LCSF_TranscoderEncodeRepr(&txMsg, txBuffer, TX_BUFF_SIZE, LCSF_REPR_STANDARD);
+    CHECK_EQUAL(msgSize, 56);
+    ExpectCheckHeader(LCSF_RECEIVE_OK);
+    ExpectReceive(LCSF_REPR_STANDARD);
+    CHECK(LCSF_TranscoderReceiveRepr(txBuffer, msgSize, LCSF_REPR_STANDARD) == LCSF_RECEIVE_OK);
+    // Test smaller representation
+#ifdef LCSF_SMALL
+    msgSize = LCSF_TranscoderEncodeRepr(&txMsg, txBuffer, TX_BUFF_SIZE, LCSF_REPR_SMALL);
+    CHECK_EQUAL(msgSize, 40);
+    ExpectCheckHeader(LCSF_RECEIVE_OK);
+    ExpectReceive(LCSF_REPR_SMALL);
+    CHECK(LCSF_TranscoderReceiveRepr(txBuffer, msgSize, LCSF_REPR_SMALL) == LCSF_RECEIVE_OK);
+#else
+    // 16-bit command id doesn't fit the smaller representation
+    CHECK_EQUAL(LCSF_TranscoderEncodeRepr(&txMsg, txBuffer, TX_BUFF_SIZE, LCSF_REPR_SMALL), -1);
+#endif
+}
+
+/**
+ * testgroup: LCSF_Transcoder
+ * testname: convert
+ *
+ * Test the representation conversion feature
+ */
+TEST(LCSF_Transcoder, convert) {
+    static const uint8_t errMsg[] = {0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01,
+        0x01, 0x00, 0x01, 0x00, 0x03};
+    static const uint8_t smallErrMsg[] = {0xff, 0x00, 0x00, 0x02, 0x00, 0x01, 0x01, 0x01, 0x01, 0x03};
+    // Message fitting both representations
+    lcsf_raw_att_t subAttArr[] = {
+        {0x32, false, sizeof(txAtt3Data), {txAtt3Data}},
+    };
+    lcsf_raw_att_t attArr[] = {
+        {0x55, false, sizeof(txAtt1Data), {txAtt1Data}},
+        {0x31, true, 1, {.pSubAttArray = subAttArr}},
+        {0x40, false, sizeof(txAtt4Data), {txAtt4Data}},
+    };
+    const lcsf_raw_msg_t msg = {0xab, 0x01, 0x12, 3, attArr};
+    uint8_t stdBuffer[TX_BUFF_SIZE];
+    uint8_t smallBuffer[TX_BUFF_SIZE];
+    int stdSize;
+    int smallSize;
+
+    // Reference buffers
+    stdSize = LCSF_TranscoderEncodeRepr(&msg, stdBuffer, TX_BUFF_SIZE, LCSF_REPR_STANDARD);
+    smallSize = LCSF_TranscoderEncodeRepr(&msg, smallBuffer, TX_BUFF_SIZE, LCSF_REPR_SMALL);
+    CHECK_EQUAL(stdSize, 8 + 4 * 4 + 5 + 2 + 16);
+    CHECK_EQUAL(smallSize, 4 + 4 * 2 + 5 + 2 + 16);
+    // Test error cases
+    CHECK_EQUAL(LCSF_TranscoderConvert(NULL, 0, LCSF_REPR_STANDARD, txBuffer, TX_BUFF_SIZE, LCSF_REPR_SMALL), -1);
+    CHECK_EQUAL(LCSF_TranscoderConvert(stdBuffer, stdSize, LCSF_REPR_STANDARD, NULL, 0, LCSF_REPR_SMALL), -1);
+    CHECK_EQUAL(LCSF_TranscoderConvert(stdBuffer, stdSize - 1, LCSF_REPR_STANDARD, txBuffer, TX_BUFF_SIZE,
+                    LCSF_REPR_SMALL),
+        -1);
+    CHECK_EQUAL(LCSF_TranscoderConvert(stdBuffer, stdSize, LCSF_REPR_STANDARD, txBuffer, smallSize - 1,
+                    LCSF_REPR_SMALL),
+        -1);
+    CHECK_EQUAL(LCSF_TranscoderConvert(badformatMsg, sizeof(badformatMsg), LCSF_REPR_DEFAULT, txBuffer,
+                    TX_BUFF_SIZE, LCSF_REPR_STANDARD),
+        -1);
+    // Test 16-bit command id doesn't fit the smaller representation
+    stdBuffer[5] = 0x01;
+    CHECK_EQUAL(LCSF_TranscoderConvert(stdBuffer, stdSize, LCSF_REPR_STANDARD, txBuffer, TX_BUFF_SIZE,
+                    LCSF_REPR_SMALL),
+        -1);
+    stdBuffer[5] = 0x00;
+    // Test valid conversions
+    CHECK_EQUAL(LCSF_TranscoderConvert(stdBuffer, stdSize, LCSF_REPR_STANDARD, txBuffer, TX_BUFF_SIZE,
+                    LCSF_REPR_SMALL),
+        smallSize);
+    MEMCMP_EQUAL(smallBuffer, txBuffer, smallSize);
+    CHECK_EQUAL(LCSF_TranscoderConvert(smallBuffer, smallSize, LCSF_REPR_SMALL, txBuffer, TX_BUFF_SIZE,
+                    LCSF_REPR_STANDARD),
+        stdSize);
+    MEMCMP_EQUAL(stdBuffer, txBuffer, stdSize);
+    CHECK_EQUAL(LCSF_TranscoderConvert(stdBuffer, stdSize, LCSF_REPR_STANDARD, txBuffer, TX_BUFF_SIZE,
+                    LCSF_REPR_STANDARD),
+        stdSize);
+    MEMCMP_EQUAL(stdBuffer, txBuffer, stdSize);
+    // Test error protocol id mapping
+    CHECK_EQUAL(LCSF_TranscoderConvert(errMsg, sizeof(errMsg), LCSF_REPR_STANDARD, txBuffer, TX_BUFF_SIZE,
+                    LCSF_REPR_SMALL),
+        (int)sizeof(smallErrMsg));
+    MEMCMP_EQUAL(smallErrMsg, txBuffer, sizeof(smallErrMsg));
+    CHECK_EQUAL(LCSF_TranscoderConvert(smallErrMsg, sizeof(smallErrMsg), LCSF_REPR_SMALL, txBuffer, TX_BUFF_SIZE,
+                    LCSF_REPR_STANDARD),
+        (int)sizeof(errMsg));
+    MEMCMP_EQUAL(errMsg, txBuffer, sizeof(errMsg));
+}
@@ -0,0 +1,116 @@
+/**
+ * @file test_LCSF_ValidCmd.cpp
+ * @brief Unit test of the LCSF_ValidCmd module
+ * @author Jean-Roland Gosse
+ *
+ * This file is part of LCSF C Stack.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ */
+
+// *** Private include ***
+#include "CppUTest/TestHarness.h"
+
+extern "C" {
+#include <string.h>
+#include "LCSF_Config.h"
+#include "LCSF_Validator.h"
+#include "LCSF_ValidCmd.h"
+#include "LCSF_Bridge_Example.h"
+#include "Example_Main.h"
+}
+
+// *** Private macros ***
+#define BLOB_SIZE 128
+
+// *** Private variables ***
+static void *detachBuffer[BLOB_SIZE / sizeof(void *)]; // Pointer aligned
+static void *queueBuffer[BLOB_SIZE / sizeof(void *)];
+static uint16_t rgbData[] = {0x1234, 0x5678, 0x9abc};
+
+// Model valid color space command with the rgb attribute only
+static lcsf_valid_att_t rgbAttArr[] = {
+    {sizeof(uint16_t), {.pData = &rgbData[0]}},
+    {sizeof(uint16_t), {.pData = &rgbData[1]}},
+    {sizeof(uint16_t), {.pData = &rgbData[2]}},
+};
+static lcsf_valid_att_t colorAttArr[] = {
+    {0, {.pData = NULL}},
+    {LCSF_EXAMPLE_ATT_RGB_SUBATT_NB, {.pSubAttArray = rgbAttArr}},
+};
+static const lcsf_valid_cmd_t colorCmd = {
+    LCSF_EXAMPLE_CMD_ID_COLOR_SPACE,
+    colorAttArr,
+};
+
+// *** Tests ***
+
+/**
+ * testgroup: LCSF_ValidCmd
+ *
+ * This group tests all the LCSF_ValidCmd features
+ */
+TEST_GROUP(LCSF_ValidCmd){};
+
+/**
+ * testgroup: LCSF_ValidCmd
+ * testname: detach
+ *
+ * Test detaching a command, moving its blob then attaching it
+ */
+TEST(LCSF_ValidCmd, detach) {
+    const lcsf_command_desc_t *pDesc = &(LCSF_Example_ProtDesc.pCmdDescArray[EXAMPLE_CMD_COLOR_SPACE]);
+    const lcsf_command_desc_t *pErrDesc = &(LCSF_Example_ProtDesc.pCmdDescArray[EXAMPLE_CMD_ERROR]);
+    uint8_t *pBlob = (uint8_t *)detachBuffer;
+    uint8_t *pQueued = (uint8_t *)queueBuffer;
+    lcsf_valid_cmd_t cmd;
+
+    // Test size query
+    int expSize = (int)(sizeof(lcsf_detached_cmd_t) + 5 * sizeof(lcsf_valid_att_t) + sizeof(rgbData));
+    CHECK_EQUAL(-1, LCSF_ValidCmdGetDetachSize(NULL, pDesc));
+    CHECK_EQUAL(expSize, LCSF_ValidCmdGetDetachSize(&colorCmd, pDesc));
+    // Test detach error cases
+    CHECK_EQUAL(-1, LCSF_ValidCmdDetach(&colorCmd, pDesc, pBlob, expSize - 1));
+    CHECK_EQUAL(-1, LCSF_ValidCmdDetach(&colorCmd, pDesc, &pBlob[1], BLOB_SIZE - 1));
+    CHECK_EQUAL(expSize, LCSF_ValidCmdDetach(&colorCmd, pDesc, pBlob, BLOB_SIZE));
+    // The blob doesn't depend on its source nor its address
+    memcpy(pQueued, pBlob, expSize);
+    memset(pBlob, 0xFF, BLOB_SIZE);
+    rgbData[0] = 0;
+    // Test attach error cases
+    CHECK_FALSE(LCSF_ValidCmdAttach(pQueued, expSize - 1, pDesc, &cmd));
+    CHECK_FALSE(LCSF_ValidCmdAttach(pQueued, expSize, pErrDesc, &cmd));
+    // Sub-attribute array out of the blob
+    lcsf_valid_att_t *pAttArray = (lcsf_valid_att_t *)&(pQueued[sizeof(lcsf_detached_cmd_t)]);
+    lcsf_valid_att_t *pRgbAtt = &(pAttArray[EXAMPLE_COLOR_SPACE_ATT_RGB]);
+    void *pOffset = pRgbAtt->Payload.pData;
+    pRgbAtt->Payload.pData = (void *)(uintptr_t)expSize;
+    CHECK_FALSE(LCSF_ValidCmdAttach(pQueued, expSize, pDesc, &cmd));
+    pRgbAtt->Payload.pData = pOffset;
+    // Test attach
+    CHECK(LCSF_ValidCmdAttach(pQueued, expSize, pDesc, &cmd));
+    CHECK_EQUAL(LCSF_EXAMPLE_CMD_ID_COLOR_SPACE, cmd.CmdId);
+    POINTERS_EQUAL(NULL, cmd.pAttArray[EXAMPLE_COLOR_SPACE_ATT_YUV].Payload.pData);
+    const lcsf_valid_att_t *pSubAttArray = cmd.pAttArray[EXAMPLE_COLOR_SPACE_ATT_RGB].Payload.pSubAttArray;
+    const uint16_t refData[] = {0x1234, 0x5678, 0x9abc};
+    for (uint16_t idx = 0; idx < LCSF_EXAMPLE_ATT_RGB_SUBATT_NB; idx++) {
+        CHECK_EQUAL(sizeof(uint16_t), pSubAttArray[idx].PayloadSize);
+        CHECK(((uint8_t *)pSubAttArray[idx].Payload.pData >= pQueued) &&
+              ((uint8_t *)pSubAttArray[idx].Payload.pData < &pQueued[expSize]));
+        MEMCMP_EQUAL(&refData[idx], pSubAttArray[idx].Payload.pData, sizeof(uint16_t));
+    }
+    rgbData[0] = refData[0];
+    // Attached blobs can't be attached again
+    CHECK_FALSE(LCSF_ValidCmdAttach(pQueued, expSize, pDesc, &cmd));
+}
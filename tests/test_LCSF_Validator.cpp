@@ -29,6 +29,7 @@ extern "C" {
 #include "LCSF_Config.h"
 #include "LCSF_Transcoder.h"
 #include "LCSF_Validator.h"
+#include "LCSF_Builder.h"
 #include "LCSF_Bridge_Example.h"
 #include "Example_Main.h"
 }
@@ -51,12 +52,25 @@ static bool compare_rawmsg(const lcsf_raw_msg_t *pMsg1, const lcsf_raw_msg_t *pM
 static void *malloc_Callback(size_t size, int num_calls);
 static bool process_Callback(const lcsf_raw_msg_t *pMsg, int num_calls);
 static bool interpret_callback(lcsf_valid_cmd_t *pValidCmd);
+static bool sparse_interpret_callback(lcsf_valid_cmd_t *pValidCmd);
+static bool swap_interpret_callback(lcsf_valid_cmd_t *pValidCmd);
+static bool error_handler_callback(lcsf_valid_cmd_t *pValidCmd);
+static bool color_handler_callback(lcsf_valid_cmd_t *pValidCmd);
+static bool hold_interpret_callback(lcsf_valid_cmd_t *pValidCmd);
+static bool nested_interpret_callback(lcsf_valid_cmd_t *pValidCmd);
+static bool reply_interpret_callback(lcsf_valid_cmd_t *pValidCmd);
 
 // *** Private variables ***
 static uint8_t txBuffer[TX_BUFF_SIZE];
 static uint8_t data_errloc = 0x00;
 static uint8_t data_errcode = ERROR_CODE;
 static uint8_t att1Data[] = {0x04};
+static lcsf_valid_cmd_t heldCmdArray[LCSF_VALIDATOR_RX_GEN_NB];
+static uint_fast16_t heldGenArray[LCSF_VALIDATOR_RX_GEN_NB];
+static size_t heldNb = 0;
+static lcsf_receive_status_t nestedStatus = LCSF_RECEIVE_OK;
+// Representation other than the default one
+static const lcsf_repr_t otherRepr = (LCSF_REPR_DEFAULT == LCSF_REPR_SMALL) ? LCSF_REPR_STANDARD : LCSF_REPR_SMALL;
 
 // Example protocol descriptor
 static const lcsf_validator_protocol_desc_t example_prot_desc = {
@@ -64,6 +78,78 @@ static const lcsf_validator_protocol_desc_t example_prot_desc = {
     LCSF_EXAMPLE_PROTOCOL_VERSION,
     &LCSF_Example_ProtDesc,
     interpret_callback,
+    false,
+    NULL,
+    NULL,
+};
+
+// Example protocol descriptor updating the protocol table from its interpreter
+static const lcsf_validator_protocol_desc_t swap_prot_desc = {
+    LCSF_EXAMPLE_PROTOCOL_ID,
+    LCSF_EXAMPLE_PROTOCOL_VERSION,
+    &LCSF_Example_ProtDesc,
+    swap_interpret_callback,
+    false,
+    NULL,
+    NULL,
+};
+
+// Example protocol descriptor holding its received commands
+static const lcsf_validator_protocol_desc_t hold_prot_desc = {
+    LCSF_EXAMPLE_PROTOCOL_ID,
+    LCSF_EXAMPLE_PROTOCOL_VERSION,
+    &LCSF_Example_ProtDesc,
+    hold_interpret_callback,
+    false,
+    NULL,
+    NULL,
+};
+
+// Example protocol descriptor receiving a message from its interpreter
+static const lcsf_validator_protocol_desc_t nested_prot_desc = {
+    LCSF_EXAMPLE_PROTOCOL_ID,
+    LCSF_EXAMPLE_PROTOCOL_VERSION,
+    &LCSF_Example_ProtDesc,
+    nested_interpret_callback,
+    false,
+    NULL,
+    NULL,
+};
+
+// Example protocol descriptor replying from its interpreter
+static const lcsf_validator_protocol_desc_t reply_prot_desc = {
+    LCSF_EXAMPLE_PROTOCOL_ID,
+    LCSF_EXAMPLE_PROTOCOL_VERSION,
+    &LCSF_Example_ProtDesc,
+    reply_interpret_callback,
+    false,
+    NULL,
+    NULL,
+};
+
+// Example protocol descriptor with an error command handler, in descriptor command order
+static LCSFInterpretCallback_t *const example_handler_array[LCSF_EXAMPLE_CMD_NB] = {
+    NULL, NULL, error_handler_callback, NULL, NULL, NULL, color_handler_callback};
+static const lcsf_validator_protocol_desc_t handler_prot_desc = {
+    LCSF_EXAMPLE_PROTOCOL_ID,
+    LCSF_EXAMPLE_PROTOCOL_VERSION,
+    &LCSF_Example_ProtDesc,
+    interpret_callback,
+    false,
+    NULL,
+    example_handler_array,
+};
+
+// Example protocol descriptor receiving sparse attribute arrays
+#define SPARSE_PROTOCOL_ID (LCSF_EXAMPLE_PROTOCOL_ID + 1)
+static const lcsf_validator_protocol_desc_t sparse_prot_desc = {
+    SPARSE_PROTOCOL_ID,
+    LCSF_EXAMPLE_PROTOCOL_VERSION,
+    &LCSF_Example_ProtDesc,
+    sparse_interpret_callback,
+    true,
+    NULL,
+    NULL,
 };
 
 // Test data
@@ -125,6 +211,52 @@ static const lcsf_raw_msg_t rxMsg = {
     rxAttArr,
 };
 
+// Model raw color space msg with the optional rgb attribute only
+static uint16_t rgbData[] = {0x1234, 0x5678, 0x9abc};
+static lcsf_raw_att_t rgbAttArr[] = {
+    {LCSF_EXAMPLE_ATT_R, false, sizeof(uint16_t), {.pData = (uint8_t *)&rgbData[0]}},
+    {LCSF_EXAMPLE_ATT_G, false, sizeof(uint16_t), {.pData = (uint8_t *)&rgbData[1]}},
+    {LCSF_EXAMPLE_ATT_B, false, sizeof(uint16_t), {.pData = (uint8_t *)&rgbData[2]}},
+};
+static lcsf_raw_att_t colorAttArr[] = {
+    {LCSF_EXAMPLE_ATT_RGB, true, LCSF_EXAMPLE_ATT_RGB_SUBATT_NB, {.pSubAttArray = rgbAttArr}},
+};
+static const lcsf_raw_msg_t sparseMsg = {
+    SPARSE_PROTOCOL_ID,
+    LCSF_EXAMPLE_PROTOCOL_VERSION,
+    LCSF_EXAMPLE_CMD_ID_COLOR_SPACE,
+    1,
+    colorAttArr,
+};
+
+// Model raw color space msg with both attributes, out of the descriptor order
+static lcsf_raw_att_t yuvAttArr[] = {
+    {LCSF_EXAMPLE_ATT_Y, false, sizeof(uint16_t), {.pData = (uint8_t *)&rgbData[0]}},
+    {LCSF_EXAMPLE_ATT_U, false, sizeof(uint16_t), {.pData = (uint8_t *)&rgbData[1]}},
+    {LCSF_EXAMPLE_ATT_V, false, sizeof(uint16_t), {.pData = (uint8_t *)&rgbData[2]}},
+};
+static lcsf_raw_att_t unorderedColorAttArr[] = {
+    {LCSF_EXAMPLE_ATT_RGB, true, LCSF_EXAMPLE_ATT_RGB_SUBATT_NB, {.pSubAttArray = rgbAttArr}},
+    {LCSF_EXAMPLE_ATT_YUV, true, LCSF_EXAMPLE_ATT_YUV_SUBATT_NB, {.pSubAttArray = yuvAttArr}},
+};
+static const lcsf_raw_msg_t unorderedColorMsg = {
+    LCSF_EXAMPLE_PROTOCOL_ID,
+    LCSF_EXAMPLE_PROTOCOL_VERSION,
+    LCSF_EXAMPLE_CMD_ID_COLOR_SPACE,
+    2,
+    unorderedColorAttArr,
+};
+
+// Model raw msg of the example protocol registered with a packed descriptor
+#define PACKED_PROTOCOL_ID (LCSF_EXAMPLE_PROTOCOL_ID + 2)
+static const lcsf_raw_msg_t packedMsg = {
+    PACKED_PROTOCOL_ID,
+    LCSF_EXAMPLE_PROTOCOL_VERSION,
+    LCSF_EXAMPLE_CMD_ID_ERROR,
+    LCSF_EXAMPLE_CMD_ERROR_ATT_NB,
+    rxAttArr,
+};
+
 // Model raw msg with a mismatched protocol version
 static const lcsf_raw_msg_t badVerMsg = {
     LCSF_EXAMPLE_PROTOCOL_ID,
@@ -163,6 +295,33 @@ static const lcsf_raw_msg_t badVerErrMsg = {
     badVerErrAttArr,
 };
 
+// Model raw msg with an error code attribute larger than its uint8 type
+static uint32_t oversizedData = 0x04;
+static lcsf_raw_att_t oversizedAttArr[] = {
+    {LCSF_EXAMPLE_ATT_ERROR_CODE, false, sizeof(oversizedData), {.pData = (uint8_t *)&oversizedData}},
+};
+static const lcsf_raw_msg_t oversizedMsg = {
+    LCSF_EXAMPLE_PROTOCOL_ID,
+    LCSF_EXAMPLE_PROTOCOL_VERSION,
+    LCSF_EXAMPLE_CMD_ID_ERROR,
+    LCSF_EXAMPLE_CMD_ERROR_ATT_NB,
+    oversizedAttArr,
+};
+
+// Model error msg expected when an attribute data size does not match its type
+static uint8_t data_wrongtype_errcode = 0x05; // LCSF_EP_ERROR_CODE_WRONG_ATT_DATA_TYPE
+static lcsf_raw_att_t wrongTypeErrAttArr[] = {
+    {0x00, false, sizeof(uint8_t), {.pData = &data_badver_errloc}},
+    {0x01, false, sizeof(uint8_t), {.pData = &data_wrongtype_errcode}},
+};
+static const lcsf_raw_msg_t wrongTypeErrMsg = {
+    ERR_PROT_ID, // ProtId
+    0x00, // ProtVer (LCSF error protocol version)
+    0x00,
+    2,
+    wrongTypeErrAttArr,
+};
+
 
 // Model valid msg
 static lcsf_valid_att_t txAttArr[] = {
@@ -290,6 +449,122 @@ static bool interpret_callback(lcsf_valid_cmd_t *pValidCmd) {
     return compare_validmsg(pValidCmd, &txMsg);
 }
 
+/**
+ * @brief      Function called by LCSF_Validator to interpret sparse messages
+ *
+ * @param      pValidCmd  The valid command
+ *
+ * @return     true if the received color space command matches sparseMsg
+ */
+static bool sparse_interpret_callback(lcsf_valid_cmd_t *pValidCmd) {
+    mock().actualCall("sparse_interpret_callback");
+    const lcsf_valid_att_t *pAttArray = pValidCmd->pAttArray;
+    // Absent yuv attribute
+    if (LCSF_ValidatorGetSparseAtt(pAttArray, LCSF_EXAMPLE_CMD_COLOR_SPACE_ATT_NB, EXAMPLE_COLOR_SPACE_ATT_YUV) != NULL) {
+        return false;
+    }
+    const lcsf_valid_att_t *pRgbAtt =
+        LCSF_ValidatorGetSparseAtt(pAttArray, LCSF_EXAMPLE_CMD_COLOR_SPACE_ATT_NB, EXAMPLE_COLOR_SPACE_ATT_RGB);
+    if ((pRgbAtt == NULL) || (LCSF_ValidatorGetSparseAtt(pAttArray, LCSF_EXAMPLE_CMD_COLOR_SPACE_ATT_NB, 2) != NULL)) {
+        return false;
+    }
+    for (uint16_t idx = 0; idx < LCSF_EXAMPLE_ATT_RGB_SUBATT_NB; idx++) {
+        const lcsf_valid_att_t *pSubAtt =
+            LCSF_ValidatorGetSparseAtt(pRgbAtt->Payload.pSubAttArray, LCSF_EXAMPLE_ATT_RGB_SUBATT_NB, idx);
+        if ((pSubAtt == NULL) || (pSubAtt->PayloadSize != sizeof(uint16_t)) ||
+            (memcmp(pSubAtt->Payload.pData, &rgbData[idx], sizeof(uint16_t)) != 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief      Function called by LCSF_Validator to interpret commands, adds the sparse protocol while receiving
+ *
+ * @param      pValidCmd  The valid command
+ *
+ * @return     true if the running receive kept its protocol table snapshot
+ */
+static bool swap_interpret_callback(lcsf_valid_cmd_t *pValidCmd) {
+    mock().actualCall("swap_interpret_callback");
+    if (!LCSF_ValidatorAddProtocol(1, &sparse_prot_desc)) {
+        return false;
+    }
+    // The replaced snapshot is held until this receive returns
+    if (LCSF_ValidatorIsRegistrySynced() || LCSF_ValidatorAddProtocol(1, &sparse_prot_desc)) {
+        return false;
+    }
+    return compare_validmsg(pValidCmd, &txMsg);
+}
+
+/**
+ * @brief      Function called by LCSF_Validator to interpret error commands
+ *
+ * @param      pValidCmd  The valid command
+ *
+ * @return     true if the command matches txMsg
+ */
+static bool error_handler_callback(lcsf_valid_cmd_t *pValidCmd) {
+    mock().actualCall("error_handler_callback");
+    return compare_validmsg(pValidCmd, &txMsg);
+}
+
+/**
+ * @brief      Function called by LCSF_Validator to interpret color space commands
+ *
+ * @param      pValidCmd  The valid command
+ *
+ * @return     true if both color attributes are received in descriptor order
+ */
+static bool color_handler_callback(lcsf_valid_cmd_t *pValidCmd) {
+    mock().actualCall("color_handler_callback");
+    const lcsf_valid_att_t *pAttArray = pValidCmd->pAttArray;
+    return (pAttArray[EXAMPLE_COLOR_SPACE_ATT_YUV].Payload.pSubAttArray != NULL) &&
+           (pAttArray[EXAMPLE_COLOR_SPACE_ATT_RGB].Payload.pSubAttArray != NULL) &&
+           (pAttArray[EXAMPLE_COLOR_SPACE_ATT_RGB].Payload.pSubAttArray[0].Payload.pData == &rgbData[0]);
+}
+
+/**
+ * @brief      Function called by LCSF_Validator to interpret commands, holds them while generations are available
+ *
+ * @param      pValidCmd  The valid command
+ *
+ * @return     true if the command matches txMsg
+ */
+static bool hold_interpret_callback(lcsf_valid_cmd_t *pValidCmd) {
+    mock().actualCall("hold_interpret_callback");
+    if ((heldNb < LCSF_VALIDATOR_RX_GEN_NB) && LCSF_ValidatorHoldCmd(&heldGenArray[heldNb])) {
+        heldCmdArray[heldNb++] = *pValidCmd;
+    }
+    return compare_validmsg(pValidCmd, &txMsg);
+}
+
+/**
+ * @brief      Function called by LCSF_Validator to interpret commands, receives a sparse message meanwhile
+ *
+ * @param      pValidCmd  The valid command
+ *
+ * @return     true if the command still matches txMsg after the nested receive
+ */
+static bool nested_interpret_callback(lcsf_valid_cmd_t *pValidCmd) {
+    mock().actualCall("nested_interpret_callback");
+    nestedStatus = LCSF_ValidatorReceive(&sparseMsg);
+    return compare_validmsg(pValidCmd, &txMsg);
+}
+
+/**
+ * @brief      Function called by LCSF_Validator to interpret commands, encodes a reply meanwhile
+ *
+ * @param      pValidCmd  The valid command
+ *
+ * @return     true if the reply was encoded
+ */
+static bool reply_interpret_callback(lcsf_valid_cmd_t *pValidCmd) {
+    mock().actualCall("reply_interpret_callback");
+    return LCSF_ValidatorEncode(LCSF_EXAMPLE_PROTOCOL_ID, pValidCmd, txBuffer, TX_BUFF_SIZE) == 0;
+}
+
 /**
  * @brief      Function called by LCSF_Validator to send error messages
  *
@@ -315,28 +590,30 @@ static void recerr_callback(uint_fast8_t errorLoc, uint_fast8_t errorType) {
 }
 
 /**
- * @brief      Expect a LCSF_TranscoderEncode call helper function
+ * @brief      Expect a LCSF_TranscoderEncodeRepr call helper function
  *
  * @param[in]  pRefMsg  Pointer to reference message
+ * @param[in]  repr     The expected representation
  */
-static void ExpectEncode(const lcsf_raw_msg_t *pRefMsg) {
+static void ExpectEncode(const lcsf_raw_msg_t *pRefMsg, lcsf_repr_t repr = LCSF_REPR_DEFAULT) {
     mock().setData("pRefMsg", (void *)pRefMsg);
-    mock().expectOneCall("LCSF_TranscoderEncode");
+    mock().expectOneCall("LCSF_TranscoderEncodeRepr").withParameter("repr", (int)repr);
 }
 
 // *** Mock Functions ***
 
 /**
- * @brief      mock LCSF_TranscoderEncode function
+ * @brief      mock LCSF_TranscoderEncodeRepr function
  *
  * @param[in]  pMessage  The message
  * @param      pBuffer   The buffer
  * @param[in]  buffSize  The buffer size
+ * @param[in]  repr      The representation
  *
  * @return     int: -1 if error, encoded message size if success
  */
-int LCSF_TranscoderEncode(const lcsf_raw_msg_t *pMessage, uint8_t* pBuffer, size_t buffSize) {
-    mock().actualCall("LCSF_TranscoderEncode");
+int LCSF_TranscoderEncodeRepr(const lcsf_raw_msg_t *pMessage, uint8_t* pBuffer, size_t buffSize, lcsf_repr_t repr) {
+    mock().actualCall("LCSF_TranscoderEncodeRepr").withParameter("repr", (int)repr);
     // Retrieve reference message
     const lcsf_raw_msg_t *pRefMsg = (const lcsf_raw_msg_t *)mock().getData("pRefMsg").getPointerValue();
     // Compare produced message with reference
@@ -376,7 +653,7 @@ TEST_GROUP(LCSF_Validator) {
 TEST(LCSF_Validator, encode)  {
     ExpectEncode(&errMsg);
     mock().expectOneCall("senderr_callback");
-    CHECK(LCSF_ValidatorSendTranscoderError(ERROR_CODE));
+    CHECK(LCSF_ValidatorSendTranscoderError(ERROR_CODE, LCSF_REPR_DEFAULT));
     CHECK_EQUAL(LCSF_ValidatorEncode(LCSF_EXAMPLE_PROTOCOL_ID, NULL, txBuffer, TX_BUFF_SIZE), -1);
     ExpectEncode(&rxMsg);
     CHECK_EQUAL(LCSF_ValidatorEncode(LCSF_EXAMPLE_PROTOCOL_ID, &txMsg, txBuffer, TX_BUFF_SIZE), 0);
@@ -406,3 +683,331 @@ TEST(LCSF_Validator, receive) {
     // Test error frame with an unexpected command id is ignored (no callback, no error sent)
     CHECK(LCSF_ValidatorReceive(&badCmdErrMsg) != LCSF_RECEIVE_OK);
 }
+
+/**
+ * testgroup: LCSF_Validator
+ * testname: receive_repr
+ *
+ * Test the replies use the representation of the received message
+ */
+TEST(LCSF_Validator, receive_repr) {
+    CHECK(LCSF_ValidatorAddProtocol(0, &reply_prot_desc));
+    CHECK(LCSF_ValidatorReceiveRepr(&rxMsg, (lcsf_repr_t)2) == LCSF_RECEIVE_ERROR);
+    // Reply in the received representation
+    mock().expectOneCall("reply_interpret_callback");
+    ExpectEncode(&rxMsg, otherRepr);
+    CHECK(LCSF_ValidatorReceiveRepr(&rxMsg, otherRepr) == LCSF_RECEIVE_OK);
+    // Default representation outside of interpretation functions
+    ExpectEncode(&rxMsg);
+    CHECK_EQUAL(LCSF_ValidatorEncode(LCSF_EXAMPLE_PROTOCOL_ID, &txMsg, txBuffer, TX_BUFF_SIZE), 0);
+}
+
+/**
+ * testgroup: LCSF_Validator
+ * testname: desc_usage
+ *
+ * Test the descriptor resource usage computation
+ */
+TEST(LCSF_Validator, desc_usage) {
+    lcsf_desc_usage_t usage;
+    CHECK_FALSE(LCSF_ValidatorGetDescUsage(NULL, &usage));
+    CHECK_FALSE(LCSF_ValidatorGetDescUsage(&LCSF_Example_ProtDesc, NULL));
+    // Worst case is the color space command: 2 attributes with 3 sub-attributes each
+    CHECK(LCSF_ValidatorGetDescUsage(&LCSF_Example_ProtDesc, &usage));
+    CHECK_EQUAL(usage.TranscoderRxItemNb, 8);
+    CHECK_EQUAL(usage.ValidatorRxItemNb, 8);
+    CHECK_EQUAL(usage.ValidatorTxItemNb, 8);
+    CHECK_EQUAL(usage.BridgeItemNb, 8);
+    CHECK_EQUAL(usage.MaxDepth, 2);
+}
+
+/**
+ * testgroup: LCSF_Validator
+ * testname: check_header
+ *
+ * Test the header check done before decoding attributes
+ */
+TEST(LCSF_Validator, check_header) {
+    CHECK(LCSF_ValidatorCheckHeader(NULL, LCSF_REPR_DEFAULT) != LCSF_RECEIVE_OK);
+    CHECK(LCSF_ValidatorCheckHeader(&rxMsg, LCSF_REPR_DEFAULT) == LCSF_RECEIVE_OK);
+    CHECK(LCSF_ValidatorCheckHeader(&errMsg, LCSF_REPR_DEFAULT) == LCSF_RECEIVE_OK);
+    // Rejected headers send the validation error back
+    ExpectEncode(&badVerErrMsg);
+    mock().expectOneCall("senderr_callback");
+    CHECK(LCSF_ValidatorCheckHeader(&badVerMsg, LCSF_REPR_DEFAULT) == LCSF_RECEIVE_BAD_PROT_VER);
+}
+
+/**
+ * testgroup: LCSF_Validator
+ * testname: receive_fixed
+ *
+ * Test the fixed layout command receive
+ */
+TEST(LCSF_Validator, receive_fixed) {
+    uint8_t buffer[16];
+    lcsf_builder_t builder;
+    lcsf_receive_status_t status;
+    size_t headerSize = (LCSF_REPR_DEFAULT == LCSF_REPR_SMALL) ? 4 : 8;
+
+    // Error command only has a non-optional uint8 attribute
+    CHECK(LCSF_BuilderBeginMsg(&builder, buffer, sizeof(buffer), LCSF_REPR_DEFAULT, LCSF_EXAMPLE_PROTOCOL_ID,
+        LCSF_EXAMPLE_PROTOCOL_VERSION, LCSF_EXAMPLE_CMD_ID_ERROR));
+    CHECK(LCSF_BuilderAddU8(&builder, LCSF_EXAMPLE_ATT_ERROR_CODE, att1Data[0]));
+    int msgSize = LCSF_BuilderEndMsg(&builder);
+    CHECK(msgSize > 0);
+    // Test error cases
+    CHECK_FALSE(LCSF_ValidatorReceiveFixed(NULL, &buffer[headerSize], msgSize - headerSize, LCSF_REPR_DEFAULT, &status));
+    CHECK_FALSE(LCSF_ValidatorReceiveFixed(&rxMsg, &buffer[headerSize], msgSize - headerSize - 1, LCSF_REPR_DEFAULT, &status));
+    CHECK_FALSE(LCSF_ValidatorReceiveFixed(&badCmdErrMsg, &buffer[headerSize], msgSize - headerSize, LCSF_REPR_DEFAULT, &status));
+    // Test fixed layout receive
+    mock().expectOneCall("interpret_callback");
+    CHECK(LCSF_ValidatorReceiveFixed(&rxMsg, &buffer[headerSize], msgSize - headerSize, LCSF_REPR_DEFAULT, &status));
+    CHECK(status == LCSF_RECEIVE_OK);
+    // Test unexpected attribute id, left to the generic decoding
+    CHECK(LCSF_BuilderBeginMsg(&builder, buffer, sizeof(buffer), LCSF_REPR_DEFAULT, LCSF_EXAMPLE_PROTOCOL_ID,
+        LCSF_EXAMPLE_PROTOCOL_VERSION, LCSF_EXAMPLE_CMD_ID_ERROR));
+    CHECK(LCSF_BuilderAddU8(&builder, LCSF_EXAMPLE_ATT_ERROR_CODE + 1, att1Data[0]));
+    msgSize = LCSF_BuilderEndMsg(&builder);
+    CHECK_FALSE(LCSF_ValidatorReceiveFixed(&rxMsg, &buffer[headerSize], msgSize - headerSize, LCSF_REPR_DEFAULT, &status));
+}
+
+#if (LCSF_VALIDATOR_SHAPE_CACHE_NB > 0)
+/**
+ * testgroup: LCSF_Validator
+ * testname: shape_cache
+ *
+ * Test the memoized validation of repeated message shapes
+ */
+TEST(LCSF_Validator, shape_cache) {
+    lcsf_shape_cache_stats_t stats;
+    CHECK_FALSE(LCSF_ValidatorGetShapeCacheStats(NULL));
+    CHECK(LCSF_ValidatorGetShapeCacheStats(&stats));
+    CHECK_EQUAL(0, stats.HitNb);
+    CHECK_EQUAL(0, stats.MissNb);
+    // First message is validated through the descriptor, the next ones reuse its shape
+    for (int idx = 0; idx < 3; idx++) {
+        mock().expectOneCall("interpret_callback");
+        CHECK(LCSF_ValidatorReceive(&rxMsg) == LCSF_RECEIVE_OK);
+    }
+    CHECK(LCSF_ValidatorGetShapeCacheStats(&stats));
+    CHECK_EQUAL(2, stats.HitNb);
+    CHECK_EQUAL(1, stats.MissNb);
+    // Invalid shapes are never memoized
+    ExpectEncode(&badVerErrMsg);
+    mock().expectOneCall("senderr_callback");
+    CHECK(LCSF_ValidatorReceive(&badVerMsg) == LCSF_RECEIVE_BAD_PROT_VER);
+    CHECK(LCSF_ValidatorGetShapeCacheStats(&stats));
+    CHECK_EQUAL(2, stats.HitNb);
+    CHECK_EQUAL(1, stats.MissNb);
+}
+#endif
+
+/**
+ * testgroup: LCSF_Validator
+ * testname: receive_sparse
+ *
+ * Test the receive feature with sparse attribute arrays
+ */
+TEST(LCSF_Validator, receive_sparse) {
+    CHECK(LCSF_ValidatorAddProtocol(1, &sparse_prot_desc));
+    CHECK(LCSF_ValidatorGetSparseAtt(NULL, LCSF_EXAMPLE_CMD_COLOR_SPACE_ATT_NB, 0) == NULL);
+    mock().expectOneCall("sparse_interpret_callback");
+    CHECK(LCSF_ValidatorReceive(&sparseMsg) == LCSF_RECEIVE_OK);
+}
+
+/**
+ * testgroup: LCSF_Validator
+ * testname: packed_desc
+ *
+ * Test the receive and encode features with a packed protocol descriptor
+ */
+TEST(LCSF_Validator, packed_desc) {
+    lcsf_packed_cmd_desc_t cmdArray[LCSF_EXAMPLE_CMD_NB];
+    lcsf_packed_att_desc_t attArray[16];
+    lcsf_packed_prot_desc_t packedDesc;
+    const lcsf_validator_protocol_desc_t packedProt = {
+        PACKED_PROTOCOL_ID, LCSF_EXAMPLE_PROTOCOL_VERSION, NULL, interpret_callback, false, &packedDesc, NULL};
+    const lcsf_validator_protocol_desc_t sparsePackedProt = {
+        SPARSE_PROTOCOL_ID, LCSF_EXAMPLE_PROTOCOL_VERSION, NULL, sparse_interpret_callback, true, &packedDesc, NULL};
+
+    // Test packing, the example protocol has 10 attributes
+    CHECK_EQUAL(6, sizeof(lcsf_packed_att_desc_t));
+    CHECK_FALSE(LCSF_ValidatorPackDesc(NULL, cmdArray, LCSF_EXAMPLE_CMD_NB, attArray, 16, &packedDesc));
+    CHECK_FALSE(LCSF_ValidatorPackDesc(&LCSF_Example_ProtDesc, cmdArray, 1, attArray, 16, &packedDesc));
+    CHECK_FALSE(LCSF_ValidatorPackDesc(&LCSF_Example_ProtDesc, cmdArray, LCSF_EXAMPLE_CMD_NB, attArray, 9, &packedDesc));
+    CHECK(LCSF_ValidatorPackDesc(&LCSF_Example_ProtDesc, cmdArray, LCSF_EXAMPLE_CMD_NB, attArray, 10, &packedDesc));
+    // Test receive and encode
+    CHECK(LCSF_ValidatorAddProtocol(1, &packedProt));
+    mock().expectOneCall("interpret_callback");
+    CHECK(LCSF_ValidatorReceive(&packedMsg) == LCSF_RECEIVE_OK);
+    ExpectEncode(&packedMsg);
+    CHECK_EQUAL(LCSF_ValidatorEncode(PACKED_PROTOCOL_ID, &txMsg, txBuffer, TX_BUFF_SIZE), 0);
+    // Test sparse receive
+    CHECK(LCSF_ValidatorAddProtocol(1, &sparsePackedProt));
+    mock().expectOneCall("sparse_interpret_callback");
+    CHECK(LCSF_ValidatorReceive(&sparseMsg) == LCSF_RECEIVE_OK);
+}
+
+/**
+ * testgroup: LCSF_Validator
+ * testname: registry_swap
+ *
+ * Test updating the protocol table while a message is received
+ */
+TEST(LCSF_Validator, registry_swap) {
+    CHECK(LCSF_ValidatorIsRegistrySynced());
+    CHECK(LCSF_ValidatorAddProtocol(0, &swap_prot_desc));
+    CHECK(LCSF_ValidatorIsRegistrySynced());
+    mock().expectOneCall("swap_interpret_callback");
+    CHECK(LCSF_ValidatorReceive(&rxMsg) == LCSF_RECEIVE_OK);
+    // The receive released the replaced snapshot, the next one uses the new table
+    CHECK(LCSF_ValidatorIsRegistrySynced());
+    mock().expectOneCall("sparse_interpret_callback");
+    CHECK(LCSF_ValidatorReceive(&sparseMsg) == LCSF_RECEIVE_OK);
+}
+
+/**
+ * testgroup: LCSF_Validator
+ * testname: cmd_handler
+ *
+ * Test receiving commands through their own handler
+ */
+TEST(LCSF_Validator, cmd_handler) {
+    uint8_t buffer[16];
+    lcsf_builder_t builder;
+    lcsf_receive_status_t status;
+    size_t headerSize = (LCSF_REPR_DEFAULT == LCSF_REPR_SMALL) ? 4 : 8;
+
+    CHECK(LCSF_ValidatorAddProtocol(0, &handler_prot_desc));
+    mock().expectOneCall("error_handler_callback");
+    CHECK(LCSF_ValidatorReceive(&rxMsg) == LCSF_RECEIVE_OK);
+    // Fixed layout path
+    CHECK(LCSF_BuilderBeginMsg(&builder, buffer, sizeof(buffer), LCSF_REPR_DEFAULT, LCSF_EXAMPLE_PROTOCOL_ID,
+        LCSF_EXAMPLE_PROTOCOL_VERSION, LCSF_EXAMPLE_CMD_ID_ERROR));
+    CHECK(LCSF_BuilderAddU8(&builder, LCSF_EXAMPLE_ATT_ERROR_CODE, att1Data[0]));
+    int msgSize = LCSF_BuilderEndMsg(&builder);
+    CHECK(msgSize > 0);
+    mock().expectOneCall("error_handler_callback");
+    CHECK(LCSF_ValidatorReceiveFixed(&rxMsg, &buffer[headerSize], msgSize - headerSize, LCSF_REPR_DEFAULT, &status));
+    CHECK(status == LCSF_RECEIVE_OK);
+    // Protocol without handlers
+    CHECK(LCSF_ValidatorAddProtocol(1, &sparse_prot_desc));
+    mock().expectOneCall("sparse_interpret_callback");
+    CHECK(LCSF_ValidatorReceive(&sparseMsg) == LCSF_RECEIVE_OK);
+}
+
+/**
+ * testgroup: LCSF_Validator
+ * testname: trusted
+ *
+ * Test receiving messages from a trusted link
+ */
+TEST(LCSF_Validator, trusted) {
+    CHECK_FALSE(LCSF_ValidatorSetTrusted(LCSF_VALIDATOR_PROTOCOL_NB, true));
+    CHECK(LCSF_ValidatorAddProtocol(0, &handler_prot_desc));
+    CHECK(LCSF_ValidatorSetTrusted(0, true));
+#if (LCSF_VALIDATOR_SHAPE_CACHE_NB > 0)
+    lcsf_shape_cache_stats_t stats;
+    CHECK(LCSF_ValidatorGetShapeCacheStats(&stats));
+    uint32_t missNb = stats.MissNb;
+#endif
+    // Messages in descriptor order are mapped by position
+    mock().expectOneCall("error_handler_callback");
+    CHECK(LCSF_ValidatorReceive(&rxMsg) == LCSF_RECEIVE_OK);
+#if (LCSF_VALIDATOR_SHAPE_CACHE_NB > 0)
+    CHECK(LCSF_ValidatorGetShapeCacheStats(&stats));
+    CHECK_EQUAL(missNb, stats.MissNb);
+#endif
+    // Other messages go through the full validation
+    mock().expectOneCall("color_handler_callback");
+    CHECK(LCSF_ValidatorReceive(&unorderedColorMsg) == LCSF_RECEIVE_OK);
+#if (LCSF_VALIDATOR_SHAPE_CACHE_NB > 0)
+    CHECK(LCSF_ValidatorGetShapeCacheStats(&stats));
+    CHECK_EQUAL(missNb + 1, stats.MissNb);
+#endif
+    // Adding the protocol again resets the link trust
+    CHECK(LCSF_ValidatorAddProtocol(0, &handler_prot_desc));
+    mock().expectOneCall("error_handler_callback");
+    CHECK(LCSF_ValidatorReceive(&rxMsg) == LCSF_RECEIVE_OK);
+#if (LCSF_VALIDATOR_SHAPE_CACHE_NB > 0)
+    CHECK(LCSF_ValidatorGetShapeCacheStats(&stats));
+    CHECK_EQUAL(missNb + 2, stats.MissNb);
+#endif
+    // Payload sizes are still checked
+    CHECK(LCSF_ValidatorSetTrusted(0, true));
+    ExpectEncode(&wrongTypeErrMsg);
+    mock().expectOneCall("senderr_callback");
+    CHECK(LCSF_ValidatorReceive(&oversizedMsg) == LCSF_RECEIVE_WRONG_ATT_DATA_TYPE);
+}
+
+/**
+ * testgroup: LCSF_Validator
+ * testname: hold_cmd
+ *
+ * Test holding received commands while the next messages are decoded
+ */
+TEST(LCSF_Validator, hold_cmd) {
+    uint_fast16_t genIdx;
+
+    // Hold outside an interpretation function
+    CHECK_FALSE(LCSF_ValidatorHoldCmd(&genIdx));
+    CHECK_FALSE(LCSF_ValidatorReleaseCmd(LCSF_VALIDATOR_RX_GEN_NB));
+    CHECK(LCSF_ValidatorAddProtocol(0, &hold_prot_desc));
+    heldNb = 0;
+    for (size_t idx = 0; idx < LCSF_VALIDATOR_RX_GEN_NB; idx++) {
+        mock().expectOneCall("hold_interpret_callback");
+        CHECK(LCSF_ValidatorReceive(&rxMsg) == LCSF_RECEIVE_OK);
+    }
+#if (LCSF_VALIDATOR_RX_GEN_NB > 1)
+    // Held commands survive the next messages
+    CHECK_EQUAL(LCSF_VALIDATOR_RX_GEN_NB, heldNb);
+    for (size_t idx = 0; idx < heldNb; idx++) {
+        CHECK(compare_validmsg(&heldCmdArray[idx], &txMsg));
+    }
+    // Messages are dropped while every generation is held
+    CHECK(LCSF_ValidatorReceive(&rxMsg) == LCSF_RECEIVE_ERROR);
+    // The released generation is reused
+    genIdx = heldGenArray[0];
+    CHECK(LCSF_ValidatorReleaseCmd(genIdx));
+    CHECK_FALSE(LCSF_ValidatorReleaseCmd(genIdx));
+    heldNb = 0;
+    mock().expectOneCall("hold_interpret_callback");
+    CHECK(LCSF_ValidatorReceive(&rxMsg) == LCSF_RECEIVE_OK);
+    CHECK_EQUAL(1, heldNb);
+    CHECK_EQUAL(genIdx, heldGenArray[0]);
+    for (size_t idx = 0; idx < LCSF_VALIDATOR_RX_GEN_NB; idx++) {
+        CHECK(LCSF_ValidatorReleaseCmd(heldGenArray[idx]));
+    }
+#else
+    // The only generation can't be held
+    CHECK_EQUAL(0, heldNb);
+#endif
+}
+
+/**
+ * testgroup: LCSF_Validator
+ * testname: nested_receive
+ *
+ * Test receiving a message from an interpretation function
+ */
+TEST(LCSF_Validator, nested_receive) {
+    uint_fast16_t genIdx;
+
+    CHECK(LCSF_ValidatorAddProtocol(0, &nested_prot_desc));
+    CHECK(LCSF_ValidatorAddProtocol(1, &sparse_prot_desc));
+    mock().expectOneCall("nested_interpret_callback");
+#if (LCSF_VALIDATOR_RX_GEN_NB > 1)
+    // The nested message uses the next generation
+    mock().expectOneCall("sparse_interpret_callback");
+    CHECK(LCSF_ValidatorReceive(&rxMsg) == LCSF_RECEIVE_OK);
+    CHECK(nestedStatus == LCSF_RECEIVE_OK);
+#else
+    // The only generation is being interpreted, the nested message is dropped
+    CHECK(LCSF_ValidatorReceive(&rxMsg) == LCSF_RECEIVE_OK);
+    CHECK(nestedStatus == LCSF_RECEIVE_ERROR);
+#endif
+    // The receive state is back to idle
+    CHECK_FALSE(LCSF_ValidatorHoldCmd(&genIdx));
+    mock().expectOneCall("sparse_interpret_callback");
+    CHECK(LCSF_ValidatorReceive(&sparseMsg) == LCSF_RECEIVE_OK);
+}
@@ -127,4 +127,52 @@ TEST(lifo, take_free) {
     CHECK(LifoGet(&TestLifo, small_size, &pData3));
     CHECK(pData3 != NULL);
     CHECK_EQUAL((uintptr_t)pData1, (uintptr_t)pData3);
-}
\ No newline at end of file
+}
+
+/**
+ * testgroup: lifo
+ * testname: region
+ *
+ * Test the lifo regions stacked on an arena
+ */
+TEST(lifo, region) {
+    lifo_desc_t region1, region2;
+    void *pData1, *pData2, *pData3;
+
+    // Bad parameters
+    CHECK_FALSE(LifoInitRegion(NULL, &TestLifo, sizeof(uint32_t)));
+    CHECK_FALSE(LifoInitRegion(&region1, NULL, sizeof(uint32_t)));
+    CHECK_FALSE(LifoInitRegion(&TestLifo, &TestLifo, sizeof(uint32_t)));
+    CHECK_FALSE(LifoInitRegion(&region1, &TestLifo, 0));
+
+    // Create arena (4 bytes items) and regions
+    CHECK(LifoInit(&TestLifo, LifoData, LIFO_SIZE / sizeof(uint32_t), sizeof(uint32_t)));
+    CHECK(LifoInitRegion(&region1, &TestLifo, sizeof(uint32_t)));
+    CHECK(LifoInitRegion(&region2, &TestLifo, 3 * sizeof(uint16_t)));
+
+    // Allocations are stacked and rounded up to arena items
+    CHECK(LifoGet(&region1, 2, &pData1));
+    CHECK(LifoGet(&region2, 3, &pData2));
+    CHECK_EQUAL((uintptr_t)pData1 + 2 * sizeof(uint32_t), (uintptr_t)pData2);
+    CHECK_EQUAL(TestLifo.FreeItemNb, LIFO_SIZE / sizeof(uint32_t) - 7);
+    CHECK(LifoGet(&region2, 1, &pData3));
+    CHECK_EQUAL((uintptr_t)pData2 + 5 * sizeof(uint32_t), (uintptr_t)pData3);
+    CHECK_EQUAL(TestLifo.FreeItemNb, LIFO_SIZE / sizeof(uint32_t) - 9);
+    CHECK_FALSE(LifoGet(&region2, LIFO_SIZE, &pData3));
+    CHECK(pData3 == NULL);
+    CHECK_FALSE(LifoFree(&region1, 1));
+
+    // Inner region release only frees its own allocations
+    CHECK(LifoFreeAll(&region2));
+    CHECK_EQUAL(TestLifo.FreeItemNb, LIFO_SIZE / sizeof(uint32_t) - 2);
+    CHECK(LifoGet(&region2, 1, &pData3));
+    CHECK_EQUAL((uintptr_t)pData2, (uintptr_t)pData3);
+
+    // Outer region release frees the whole arena, inner region release is then harmless
+    CHECK(LifoFreeAll(&region1));
+    CHECK_EQUAL(TestLifo.FreeItemNb, LIFO_SIZE / sizeof(uint32_t));
+    CHECK(LifoFreeAll(&region2));
+    CHECK_EQUAL(TestLifo.FreeItemNb, LIFO_SIZE / sizeof(uint32_t));
+    CHECK(LifoGet(&region2, 1, &pData3));
+    CHECK_EQUAL((uintptr_t)pData1, (uintptr_t)pData3);
+}